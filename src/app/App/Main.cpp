@@ -1,16 +1,31 @@
 #define SDL_MAIN_HANDLED
 
+#include <cstddef>
 #include <exception>
+#include <span>
+#include <utility>
 
 #include "Core/Application.hpp"
 #include "Core/Debug/Instrumentor.hpp"
+#include "Core/Headless.hpp"
 #include "Core/Log.hpp"
 
-int main() {
+int main(int argc, char* argv[]) {
+  const std::span<char* const> arguments(argv, static_cast<std::size_t>(argc));
+  App::ExitStatus status{App::ExitStatus::SUCCESS};
+
   try {
     APP_PROFILE_BEGIN_SESSION_WITH_FILE("App", "profile.json");
 
-    {
+    if (App::HeadlessSettings::requested(arguments)) {
+      APP_PROFILE_SCOPE("Headless");
+      if (auto settings = App::HeadlessSettings::parse(arguments)) {
+        App::HeadlessRenderer renderer{std::move(*settings)};
+        status = renderer.run();
+      } else {
+        status = App::ExitStatus::FAILURE;
+      }
+    } else {
       APP_PROFILE_SCOPE("Test scope");
       App::Application app{"App"};
       app.run();
@@ -19,7 +34,8 @@ int main() {
     APP_PROFILE_END_SESSION();
   } catch (std::exception& e) {
     APP_ERROR("Main process terminated with: {}", e.what());
+    status = App::ExitStatus::FAILURE;
   }
 
-  return 0;
+  return static_cast<int>(status);
 }
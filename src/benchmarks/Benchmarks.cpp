@@ -0,0 +1,408 @@
+#define SDL_MAIN_HANDLED
+
+#include <SDL2/SDL.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <fmt/format.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/ExpressionCache.hpp"
+#include "Core/Plot/PlotLayer.hpp"
+#include "Core/Plot/PlotSampler.hpp"
+#include "Core/ThreadPool.hpp"
+
+// Times the plotting kernels outside the GUI over a fixed corpus of expressions, zoom
+// levels and canvas sizes, and writes the results as JSON:
+//
+//   Benchmarks [--out <file.json> | --out -] [--repetitions <n>] [--filter <text>]
+//
+// Every case is run `repetitions` times after one untimed warm-up; the median and the
+// fastest run are reported together with the throughput of the median run.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+struct CorpusEntry {
+  std::string_view category;
+  std::string_view expression;
+};
+
+// Smooth and oscillating curves, poles, and curves with many or sharp features per mode
+constexpr std::array<CorpusEntry, 13> corpus{{
+    {"explicit", "sin(x)"},
+    {"explicit", "x^3 - 4*x"},
+    {"explicit", "tan(x)"},
+    {"explicit", "sin(1/x)"},
+    {"polar", "r = 1 + cos(theta)"},
+    {"polar", "r = sin(5*theta)"},
+    {"parametric", "(cos(3*t), sin(2*t))"},
+    {"parametric", "(t*cos(t), t*sin(t))"},
+    {"implicit", "x^2 + y^2 = 16"},
+    {"implicit", "y^2 = x^3 - x"},
+    {"implicit", "sin(x*y) = 0.5"},
+    {"inequality", "x^2 + y^2 < 25"},
+    {"inequality", "sin(x) + cos(y) > 0.5"},
+}};
+
+struct CanvasSize {
+  int width;
+  int height;
+};
+
+constexpr std::array<float, 3> zoom_levels{25.0F, 100.0F, 400.0F};
+constexpr std::array<CanvasSize, 3> canvas_sizes{{{800, 600}, {1920, 1080}, {3840, 2160}}};
+constexpr float line_thickness = 6.0F;
+
+struct Options {
+  int repetitions{5};
+  std::string filter;
+  std::string output{"benchmarks.json"};
+};
+
+struct Timing {
+  double median_ms{0.0};
+  double min_ms{0.0};
+};
+
+std::optional<Options> parse_options(std::span<char* const> arguments) {
+  Options options;
+  for (std::size_t i = 1; i < arguments.size(); ++i) {
+    const std::string_view option(arguments[i]);
+    if (i + 1 >= arguments.size()) {
+      fmt::print(stderr, "Missing value for {}\n", option);
+      return std::nullopt;
+    }
+    const std::string_view value(arguments[++i]);
+
+    if (option == "--out") {
+      options.output = value;
+    } else if (option == "--filter") {
+      options.filter = value;
+    } else if (option == "--repetitions") {
+      const auto [end, error] =
+          std::from_chars(value.data(), value.data() + value.size(), options.repetitions);
+      if (error != std::errc{} || end != value.data() + value.size() ||
+          options.repetitions < 1) {
+        fmt::print(stderr, "Invalid --repetitions '{}'\n", value);
+        return std::nullopt;
+      }
+    } else {
+      fmt::print(stderr, "Unknown option {}\n", option);
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+// Runs `setup` untimed before each of one warm-up and `repetitions` timed runs of `body`.
+Timing measure(int repetitions,
+    const std::function<void()>& setup,
+    const std::function<void()>& body) {
+  setup();
+  body();
+
+  std::vector<double> runs;
+  runs.reserve(static_cast<std::size_t>(repetitions));
+  for (int i = 0; i < repetitions; ++i) {
+    setup();
+    const auto start = Clock::now();
+    body();
+    runs.push_back(Milliseconds(Clock::now() - start).count());
+  }
+
+  std::sort(runs.begin(), runs.end());
+  return {runs[runs.size() / 2], runs.front()};
+}
+
+double per_second(std::size_t count, double milliseconds) {
+  return milliseconds > 0.0 ? static_cast<double>(count) * 1000.0 / milliseconds : 0.0;
+}
+
+std::string json_string(std::string_view text) {
+  std::string out = "\"";
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+// Dear ImGui on an SDL software renderer, so draw lists and region textures can be built
+// without a display, as in the headless mode.
+class DrawContext {
+ public:
+  explicit DrawContext(CanvasSize size) {
+    m_surface =
+        SDL_CreateRGBSurfaceWithFormat(0, size.width, size.height, 32, SDL_PIXELFORMAT_ABGR8888);
+    if (m_surface != nullptr) {
+      m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io{ImGui::GetIO()};
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(static_cast<float>(size.width), static_cast<float>(size.height));
+    io.DeltaTime = 1.0F / 60.0F;
+    if (m_renderer != nullptr) {
+      ImGui_ImplSDLRenderer2_Init(m_renderer);
+    }
+  }
+
+  ~DrawContext() {
+    if (m_renderer != nullptr) {
+      ImGui_ImplSDLRenderer2_Shutdown();
+    }
+    ImGui::DestroyContext();
+    if (m_renderer != nullptr) {
+      SDL_DestroyRenderer(m_renderer);
+    }
+    if (m_surface != nullptr) {
+      SDL_FreeSurface(m_surface);
+    }
+  }
+
+  DrawContext(const DrawContext&) = delete;
+  DrawContext(DrawContext&&) = delete;
+  DrawContext& operator=(DrawContext other) = delete;
+  DrawContext& operator=(DrawContext&& other) = delete;
+
+  [[nodiscard]] bool valid() const {
+    return m_renderer != nullptr;
+  }
+
+  [[nodiscard]] SDL_Renderer* renderer() const {
+    return m_renderer;
+  }
+
+ private:
+  SDL_Surface* m_surface{nullptr};
+  SDL_Renderer* m_renderer{nullptr};
+};
+
+class Suite {
+ public:
+  explicit Suite(Options options) : m_options(std::move(options)), m_sampler(m_thread_pool) {}
+
+  bool run() {
+    const CanvasSize largest = canvas_sizes.back();
+    DrawContext context(largest);
+    if (!context.valid()) {
+      fmt::print(stderr, "Error creating software renderer: {}\n", SDL_GetError());
+      return false;
+    }
+    m_layer = std::make_unique<App::Plot::PlotLayer>(context.renderer());
+
+    for (const CorpusEntry& entry : corpus) {
+      if (!m_options.filter.empty() &&
+          entry.expression.find(m_options.filter) == std::string_view::npos &&
+          entry.category.find(m_options.filter) == std::string_view::npos) {
+        continue;
+      }
+
+      run_compile(entry);
+
+      const bool view_dependent =
+          entry.category == "explicit" || entry.category == "implicit" ||
+          entry.category == "inequality";
+      // Parametric and polar curves cover a fixed parameter range, one view is enough
+      const std::span<const float> zooms =
+          view_dependent ? std::span<const float>(zoom_levels) : std::span(zoom_levels).first(1);
+      const std::span<const CanvasSize> canvases = view_dependent
+                                                       ? std::span<const CanvasSize>(canvas_sizes)
+                                                       : std::span(canvas_sizes).first(1);
+
+      for (const float zoom : zooms) {
+        for (const CanvasSize canvas : canvases) {
+          if (entry.category == "implicit") {
+            run_sampling(entry, "grid", zoom, canvas, App::Plot::ImplicitEngine::Grid);
+            run_sampling(entry, "quadtree", zoom, canvas, App::Plot::ImplicitEngine::Quadtree);
+          } else {
+            run_sampling(entry, "", zoom, canvas, App::Plot::ImplicitEngine::Grid);
+          }
+        }
+      }
+    }
+
+    m_layer.reset();
+    return write_json();
+  }
+
+ private:
+  void run_compile(const CorpusEntry& entry) {
+    const std::string text(entry.expression);
+    std::unique_ptr<App::Plot::ExpressionCache> cache;
+
+    const Timing timing = measure(
+        m_options.repetitions,
+        [&cache] { cache = std::make_unique<App::Plot::ExpressionCache>(); },
+        [&cache, &text] { cache->get(text); });
+
+    fmt::print("compile  {:<10} {:<24} {:9.3f} ms\n", entry.category, text, timing.median_ms);
+    m_records.push_back(fmt::format(
+        R"({{"benchmark": "compile", "category": {}, "expression": {}, "median_ms": {:.6f}, )"
+        R"("min_ms": {:.6f}, "compiles_per_second": {:.1f}}})",
+        json_string(entry.category),
+        json_string(text),
+        timing.median_ms,
+        timing.min_ms,
+        per_second(1, timing.median_ms)));
+  }
+
+  void run_sampling(const CorpusEntry& entry,
+      std::string_view engine,
+      float zoom,
+      CanvasSize canvas,
+      App::Plot::ImplicitEngine implicit_engine) {
+    const std::string text(entry.expression);
+    m_expressions.get(text);
+
+    const App::Plot::PlotView view{zoom,
+        ImVec2(static_cast<float>(canvas.width), static_cast<float>(canvas.height)),
+        ImVec2(0.0F, 0.0F),
+        implicit_engine};
+
+    // Cached tiles would turn every run after the first into a copy
+    const Timing sampling = measure(
+        m_options.repetitions,
+        [this] { m_sampler.clear_tiles(); },
+        [this, &view] { m_sampler.sample(m_expressions, view, 1.0, {}, m_result); });
+    const std::size_t evaluations = m_sampler.evaluations();
+
+    // Draw list generation, including the region texture upload of inequalities
+    const ImVec2 origin(view.canvas_size.x * 0.5F, view.canvas_size.y * 0.5F);
+    std::size_t vertices = 0;
+    const Timing drawing = measure(
+        m_options.repetitions,
+        [this] {
+          ImGui_ImplSDLRenderer2_NewFrame();
+          ImGui::NewFrame();
+          m_scratch.reset();
+          App::Plot::PlotResult copy = m_result;
+          m_layer->update(std::move(copy));
+        },
+        [this, &origin, &vertices, zoom] {
+          ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
+          m_layer->draw(draw_list, origin, zoom, line_thickness, m_scratch);
+          vertices = static_cast<std::size_t>(draw_list->VtxBuffer.Size);
+          ImGui::EndFrame();
+        });
+
+    fmt::print("sample   {:<10} {:<24} {:<8} zoom {:5.0f} {:4}x{:<4} {:9.3f} ms {:8.2f} M/s | "
+               "draw {:9.3f} ms {:8.2f} Mvtx/s\n",
+        entry.category,
+        text,
+        engine,
+        zoom,
+        canvas.width,
+        canvas.height,
+        sampling.median_ms,
+        per_second(evaluations, sampling.median_ms) / 1e6,
+        drawing.median_ms,
+        per_second(vertices, drawing.median_ms) / 1e6);
+
+    m_records.push_back(fmt::format(
+        R"({{"benchmark": "sample", "category": {}, "expression": {}, "engine": {}, )"
+        R"("zoom": {}, "width": {}, "height": {}, )"
+        R"("sample": {{"median_ms": {:.6f}, "min_ms": {:.6f}, "samples": {}, )"
+        R"("samples_per_second": {:.1f}}}, )"
+        R"("draw": {{"median_ms": {:.6f}, "min_ms": {:.6f}, "vertices": {}, )"
+        R"("vertices_per_second": {:.1f}}}}})",
+        json_string(entry.category),
+        json_string(text),
+        json_string(engine),
+        zoom,
+        canvas.width,
+        canvas.height,
+        sampling.median_ms,
+        sampling.min_ms,
+        evaluations,
+        per_second(evaluations, sampling.median_ms),
+        drawing.median_ms,
+        drawing.min_ms,
+        vertices,
+        per_second(vertices, drawing.median_ms)));
+  }
+
+  bool write_json() const {
+#ifdef NDEBUG
+    constexpr bool optimized = true;
+#else
+    constexpr bool optimized = false;
+#endif
+
+    std::string json = fmt::format(
+        "{{\n  \"threads\": {},\n  \"repetitions\": {},\n  \"optimized\": {},\n  \"results\": [",
+        m_thread_pool.size(),
+        m_options.repetitions,
+        optimized);
+    for (std::size_t i = 0; i < m_records.size(); ++i) {
+      json += i == 0 ? "\n    " : ",\n    ";
+      json += m_records[i];
+    }
+    json += "\n  ]\n}\n";
+
+    if (m_options.output == "-") {
+      fmt::print("{}", json);
+      return true;
+    }
+
+    std::ofstream file(m_options.output, std::ios::binary);
+    file << json;
+    if (!file.good()) {
+      fmt::print(stderr, "Could not write {}\n", m_options.output);
+      return false;
+    }
+    fmt::print("Wrote {} results to {}\n", m_records.size(), m_options.output);
+    return true;
+  }
+
+  Options m_options;
+  App::ThreadPool m_thread_pool;
+  App::Plot::ExpressionCache m_expressions;
+  App::Plot::PlotSampler m_sampler;
+  App::Plot::PlotResult m_result;
+  std::unique_ptr<App::Plot::PlotLayer> m_layer;
+  App::FrameArena m_scratch;
+  std::vector<std::string> m_records;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::span<char* const> arguments(argv, static_cast<std::size_t>(argc));
+
+  try {
+    auto options = parse_options(arguments);
+    if (!options) {
+      return 1;
+    }
+
+    Suite suite(std::move(*options));
+    return suite.run() ? 0 : 1;
+  } catch (std::exception& e) {
+    fmt::print(stderr, "Benchmarks terminated with: {}\n", e.what());
+    return 1;
+  }
+}
@@ -5,22 +5,107 @@
 #include <backends/imgui_impl_sdlrenderer2.h>
 #include <imgui.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "Core/DPIHandler.hpp"
+#include "Core/Debug/FrameStats.hpp"
 #include "Core/Debug/Instrumentor.hpp"
+#include "Core/Debug/PerformancePanel.hpp"
+#include "Core/FrameArena.hpp"
 #include "Core/Log.hpp"
 #include "Core/Resources.hpp"
 #include "Core/Window.hpp"
+#include "Core/Plot/Axes.hpp"
+#include "Core/Plot/DataLayer.hpp"
+#include "Core/Plot/DataSeries.hpp"
+#include "Core/Plot/LayerCache.hpp"
+#include "Core/Plot/PlotDescription.hpp"
+#include "Core/Plot/PlotEvaluator.hpp"
+#include "Core/Plot/PlotLayer.hpp"
+#include "Core/Plot/StreamLayer.hpp"
+#include "Core/Plot/StreamSource.hpp"
 #include "Settings/Project.hpp"
-#include "exprtk.hpp"
-#include "funcs.hpp"
 
 namespace App {
 
+namespace {
+
+// Frames drawn after the last event before the loop starts waiting
+constexpr int frames_after_input = 3;
+constexpr int idle_timeout_ms = 1000;
+constexpr int caret_blink_ms = 400;
+constexpr int busy_timeout_ms = 100;
+
+// Colors of new expression layers, in turn
+constexpr std::array<ImU32, 6> layer_colors{
+    IM_COL32(199, 68, 64, 255),
+    IM_COL32(64, 128, 199, 255),
+    IM_COL32(64, 170, 110, 255),
+    IM_COL32(128, 64, 199, 255),
+    IM_COL32(190, 160, 20, 255),
+    IM_COL32(20, 160, 170, 255),
+};
+
+// Expression layers with a texture of their own; the ones after them share one
+constexpr std::size_t max_layer_textures = 16;
+
+// Folds `value` into `seed`, e.g. to key a texture on the revisions of several layers
+std::uint64_t combine(std::uint64_t seed, std::uint64_t value) {
+  return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6U) + (seed >> 2U));
+}
+
+// Posts `event_type` so a main loop waiting for events draws a frame, from any thread.
+std::function<void()> wake_main_loop(std::uint32_t event_type) {
+  return [event_type] {
+    if (event_type != static_cast<std::uint32_t>(-1)) {
+      SDL_Event wake{};
+      wake.type = event_type;
+      SDL_PushEvent(&wake);
+    }
+  };
+}
+
+}  // namespace
+
+// One expression of the layer list. The evaluator knows it by `id`.
+struct Application::ExpressionLayer {
+  ExpressionLayer(std::uint64_t layer_id,
+      SDL_Renderer* renderer,
+      const char* initial_text,
+      ImU32 initial_color)
+      : id(layer_id),
+        color(ImGui::ColorConvertU32ToFloat4(initial_color)),
+        plot(renderer),
+        cache(renderer) {
+    std::snprintf(text.data(), text.size(), "%s", initial_text);
+    plot.set_color(initial_color);
+  }
+
+  std::uint64_t id;
+  std::array<char, 1024> text{};
+  ImVec4 color;
+  bool visible{true};
+  Plot::PlotLayer plot;
+  // Drawn again only when the plot's revision or the view changes
+  Plot::LayerCache cache;
+
+  // `text` as of its last description, which lists the parameters it reads
+  std::string described_text;
+  Plot::PlotDescription description;
+  // Values of description.parameters, in order
+  std::vector<double> parameter_values;
+};
+
 Application::Application(const std::string& title) {
   APP_PROFILE_FUNCTION();
 
@@ -31,11 +116,35 @@ Application::Application(const std::string& title) {
   }
 
   m_window = std::make_unique<Window>(Window::Settings{title});
+  // Completed plots and streamed samples wake the main loop when it is waiting for events
+  m_wake_event = SDL_RegisterEvents(1);
+  m_plot_evaluator = std::make_unique<Plot::PlotEvaluator>(wake_main_loop(m_wake_event));
+  m_data_layer = std::make_unique<Plot::DataLayer>();
+  m_stream_layer = std::make_unique<Plot::StreamLayer>();
+  m_axes_cache = std::make_unique<Plot::LayerCache>(m_window->get_native_renderer());
+  m_overflow_cache = std::make_unique<Plot::LayerCache>(m_window->get_native_renderer());
+  m_data_cache = std::make_unique<Plot::LayerCache>(m_window->get_native_renderer());
+  m_stream_cache = std::make_unique<Plot::LayerCache>(m_window->get_native_renderer());
+  m_performance_panel = std::make_unique<Debug::PerformancePanel>();
+  m_frame_arena = std::make_unique<FrameArena>();
+  add_expression_layer("r = 1 + 0.5*cos(theta)");
 }
 
 Application::~Application() {
   APP_PROFILE_FUNCTION();
 
+  // Their threads wake the main loop through SDL's event queue, so they are joined before
+  // SDL shuts down
+  m_stream_layer.reset();
+  m_plot_evaluator.reset();
+
+  // The plot textures belong to the window's renderer
+  m_expression_layers.clear();
+  m_axes_cache.reset();
+  m_overflow_cache.reset();
+  m_data_cache.reset();
+  m_stream_cache.reset();
+
   ImGui_ImplSDLRenderer2_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
@@ -88,41 +197,207 @@ ExitStatus App::Application::run() {
     APP_PROFILE_SCOPE("MainLoop");
 
     SDL_Event event{};
-    while (SDL_PollEvent(&event) == 1) {
-      APP_PROFILE_SCOPE("EventPolling");
+    bool has_event = false;
+    bool settled = false;
+
+    // Power saving: once the last input has been drawn, sleep until the next event. A
+    // completed background plot arrives as an event too; a blinking text cursor and a job
+    // still in flight only shorten the wait.
+    if (m_power_saving && m_frames_to_render == 0) {
+      APP_PROFILE_SCOPE("EventWaiting");
+
+      int timeout_ms = idle_timeout_ms;
+      if (io.WantTextInput) {
+        timeout_ms = caret_blink_ms;
+      } else if (m_plot_evaluator->busy()) {
+        timeout_ms = busy_timeout_ms;
+      }
 
-      ImGui_ImplSDL2_ProcessEvent(&event);
+      has_event = SDL_WaitEventTimeout(&event, timeout_ms) == 1;
+      settled = !has_event && !io.WantTextInput;
+    } else {
+      has_event = SDL_PollEvent(&event) == 1;
+    }
 
-      if (event.type == SDL_QUIT) {
-        stop();
-      }
+    {
+      APP_PROFILE_STAGE(Debug::Stage::EventPolling, "EventPolling");
+
+      while (has_event) {
+        ImGui_ImplSDL2_ProcessEvent(&event);
 
-      if (event.type == SDL_WINDOWEVENT &&
-          event.window.windowID == SDL_GetWindowID(m_window->get_native_window())) {
-        on_event(event.window);
+        if (event.type == SDL_QUIT) {
+          stop();
+        }
+
+        if (event.type == SDL_WINDOWEVENT &&
+            event.window.windowID == SDL_GetWindowID(m_window->get_native_window())) {
+          on_event(event.window);
+        }
+
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+          on_render_reset();
+        }
+
+        // ImGui needs a few frames to settle hover and activation state after input
+        m_frames_to_render = frames_after_input;
+        has_event = SDL_PollEvent(&event) == 1;
       }
     }
 
+    // Neither the retained plot nor the UI changed, so the last presented frame is current
+    if (settled && !m_plot_evaluator->busy()) {
+      continue;
+    }
+    if (m_frames_to_render > 0) {
+      --m_frames_to_render;
+    }
+
+    // Waiting for events is not part of the frame
+    const Debug::StageTimer frame_timer(Debug::Stage::Frame);
+    Debug::StageTimer draw_list_timer(Debug::Stage::DrawList);
+
     // Start the Dear ImGui frame
     ImGui_ImplSDLRenderer2_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
+    m_frame_arena->reset();
+
+    // Streamed samples are taken even while minimized so the source does not fall behind
+    m_stream_layer->update();
 
     if (!m_minimized) {
       const ImGuiViewport* viewport = ImGui::GetMainViewport();
       const ImVec2 base_pos = viewport->Pos;
       const ImVec2 base_size = viewport->Size;
 
-      static char function[1024] = "r = 1 + 0.5*cos(theta)";
       static float zoom = 100.0f;
+      static ImVec2 center{0.0f, 0.0f};
+      static int implicit_engine = static_cast<int>(Plot::ImplicitEngine::Grid);
+      static int tile_cache_mib = static_cast<int>(Plot::TileCache::default_capacity >> 20U);
+      static char data_path[1024] = "";
+      static double data_x_offset = 0.0;
+      static double data_x_scale = 1.0;
+      static int stream_endpoint = static_cast<int>(StreamEndpoint::Stdin);
+      static char stream_path[1024] = "";
+      static int stream_encoding = static_cast<int>(Plot::StreamEncoding::Text);
+      static int stream_overflow = static_cast<int>(Plot::StreamOverflow::Drop);
+      static bool stream_follow = true;
 
       // Left Pane (expression)
       {
         ImGui::SetNextWindowPos(base_pos);
         ImGui::SetNextWindowSize(ImVec2(base_size.x * 0.25f, base_size.y));
         ImGui::Begin("Left Pane", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar);
-        ImGui::InputTextMultiline("##search", function, sizeof(function), ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 4));
+
+        // The layer list: each expression can be hidden, which stops its evaluation too
+        std::optional<std::size_t> removed_layer;
+        for (std::size_t i = 0; i < m_expression_layers.size(); ++i) {
+          ExpressionLayer& layer = *m_expression_layers[i];
+          ImGui::PushID(static_cast<int>(layer.id));
+          // A hidden layer gives back its texture, and its tiles and results in the
+          // evaluator; showing it again submits it anew
+          if (ImGui::Checkbox("##visible", &layer.visible) && !layer.visible) {
+            layer.cache.reset();
+            m_plot_evaluator->remove(layer.id);
+          }
+          ImGui::SameLine();
+          if (ImGui::ColorEdit3("##color", &layer.color.x, ImGuiColorEditFlags_NoInputs)) {
+            layer.plot.set_color(ImGui::ColorConvertFloat4ToU32(layer.color));
+          }
+          ImGui::SameLine();
+          if (ImGui::SmallButton("Remove")) {
+            removed_layer = i;
+          }
+          ImGui::InputTextMultiline("##expression",
+              layer.text.data(),
+              layer.text.size(),
+              ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2.5f));
+          ImGui::PopID();
+        }
+        if (removed_layer) {
+          m_plot_evaluator->remove(m_expression_layers[*removed_layer]->id);
+          m_expression_layers.erase(
+              m_expression_layers.begin() + static_cast<std::ptrdiff_t>(*removed_layer));
+        }
+        if (ImGui::Button("Add expression")) {
+          add_expression_layer("");
+        }
+
+        update_parameters();
+
         ImGui::SliderFloat("Graph Scale", &zoom, 10.0f, 500.0f, "%.1f");
+        const char* implicit_engines[] = {"Grid", "Quadtree"};
+        ImGui::Combo(
+            "Implicit engine", &implicit_engine, implicit_engines, IM_ARRAYSIZE(implicit_engines));
+        ImGui::Checkbox("Power saving", &m_power_saving);
+        ImGui::Checkbox("Performance panel", &m_show_debug_panel);
+        if (ImGui::Button("Reset view")) {
+          center = ImVec2(0.0f, 0.0f);
+        }
+        if (ImGui::SliderInt("Tile cache (MiB)", &tile_cache_mib, 16, 1024)) {
+          m_plot_evaluator->set_tile_cache_capacity(
+              static_cast<std::size_t>(tile_cache_mib) << 20U);
+        }
+
+        // Measured data drawn over the plot: CSV, or raw .f32/.f64 columns of y values
+        ImGui::SeparatorText("Data");
+        ImGui::InputText("File", data_path, sizeof(data_path));
+        ImGui::InputDouble("x offset", &data_x_offset);
+        ImGui::InputDouble("x scale", &data_x_scale);
+        if (data_x_scale > 0.0) {
+          m_data_layer->set_x_mapping(data_x_offset, data_x_scale);
+        }
+        if (ImGui::Button("Load")) {
+          const Plot::DataSource source{data_path, Plot::DataSource::format_for(data_path)};
+          m_data_layer->set_series(Plot::DataSeries::load(source));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+          m_data_layer->set_series(nullptr);
+        }
+        if (const Plot::DataSeries* series = m_data_layer->series()) {
+          ImGui::Text("%zu samples, drawn from level %zu", series->size(), m_data_layer->level());
+        }
+
+        // Samples streamed by another process, read on a background thread
+        ImGui::SeparatorText("Stream");
+        const char* stream_endpoints[] = {"stdin", "FIFO", "Unix socket"};
+        ImGui::Combo("Source", &stream_endpoint, stream_endpoints, IM_ARRAYSIZE(stream_endpoints));
+        if (stream_endpoint != static_cast<int>(StreamEndpoint::Stdin)) {
+          ImGui::InputText("Path", stream_path, sizeof(stream_path));
+        }
+        const char* stream_encodings[] = {"Text lines", "Binary (x, y) doubles"};
+        ImGui::Combo(
+            "Encoding", &stream_encoding, stream_encodings, IM_ARRAYSIZE(stream_encodings));
+        const char* stream_overflows[] = {"Drop samples", "Hold back the writer"};
+        ImGui::Combo(
+            "When behind", &stream_overflow, stream_overflows, IM_ARRAYSIZE(stream_overflows));
+        if (ImGui::Button("Connect")) {
+          m_stream_layer->connect({static_cast<StreamEndpoint>(stream_endpoint), stream_path,
+                                      static_cast<Plot::StreamEncoding>(stream_encoding),
+                                      static_cast<Plot::StreamOverflow>(stream_overflow)},
+              wake_main_loop(m_wake_event));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Disconnect")) {
+          m_stream_layer->disconnect();
+        }
+        ImGui::Checkbox("Follow newest sample", &stream_follow);
+        if (const Plot::StreamSource* stream = m_stream_layer->source()) {
+          const char* states[] = {"Connecting", "Streaming", "Ended", "Failed"};
+          const Plot::StreamCounters counters = stream->counters();
+          ImGui::Text("%s, %.0f samples/s",
+              states[static_cast<int>(stream->state())],
+              m_stream_layer->rate());
+          ImGui::Text("Received %llu samples (%llu bytes)",
+              static_cast<unsigned long long>(counters.samples),
+              static_cast<unsigned long long>(counters.bytes));
+          ImGui::Text("Dropped %llu, held back %llu, malformed %llu",
+              static_cast<unsigned long long>(counters.dropped),
+              static_cast<unsigned long long>(counters.blocked),
+              static_cast<unsigned long long>(counters.malformed));
+          ImGui::Text("Queue %zu / %zu", stream->queued(), Plot::StreamSource::ring_capacity);
+        }
         ImGui::End();
       }
 
@@ -136,366 +411,129 @@ ExitStatus App::Application::run() {
         const ImVec2 canvas_p0 = ImGui::GetCursorScreenPos();
         const ImVec2 canvas_sz = ImGui::GetContentRegionAvail();
         const auto canvas_p1 = ImVec2(canvas_p0.x + canvas_sz.x, canvas_p0.y + canvas_sz.y);
-        const ImVec2 origin(canvas_p0.x + canvas_sz.x * 0.5f, canvas_p0.y + canvas_sz.y * 0.5f);
-        float lineThickness = 6.0f;
-        
-        // --- Thin integer gridlines with adaptive spacing ---
-        const ImU32 gridColor = IM_COL32(200, 200, 200, 255); // light gray
-        const float gridThickness = 1.0f;                     // thin lines
-        const float minPixelSpacing = 20.0f;                  // minimum spacing in pixels
-        
-        // Dynamic step based on zoom
-        float step = 1.0f;
-        while (step * zoom < minPixelSpacing)
-        step *= 2.0f;
-        
-        
-        // Vertical gridlines
-        for (float x = 0; origin.x + x * zoom < canvas_p1.x; x += step) {
-          if (x != 0) {
-            draw_list->AddLine(ImVec2(origin.x + x * zoom, canvas_p0.y),
-            ImVec2(origin.x + x * zoom, canvas_p1.y),
-            gridColor, gridThickness);
-            draw_list->AddLine(ImVec2(origin.x - x * zoom, canvas_p0.y),
-            ImVec2(origin.x - x * zoom, canvas_p1.y),
-            gridColor, gridThickness);
-          }
-        }
-        
-        // Horizontal gridlines
-        for (float y = 0; origin.y + y * zoom < canvas_p1.y; y += step) {
-          if (y != 0) {
-            draw_list->AddLine(ImVec2(canvas_p0.x, origin.y + y * zoom),
-            ImVec2(canvas_p1.x, origin.y + y * zoom),
-            gridColor, gridThickness);
-            draw_list->AddLine(ImVec2(canvas_p0.x, origin.y - y * zoom),
-            ImVec2(canvas_p1.x, origin.y - y * zoom),
-            gridColor, gridThickness);
-          }
-        }
-        
-        draw_list->AddLine(ImVec2(canvas_p0.x, origin.y), ImVec2(canvas_p1.x, origin.y), IM_COL32(0, 0, 0, 255), lineThickness);
-        draw_list->AddLine(ImVec2(origin.x, canvas_p0.y), ImVec2(origin.x, canvas_p1.y), IM_COL32(0, 0, 0, 255), lineThickness);
-        std::vector<ImVec2> points;
-
-        // (f(t), g(t))
-        std::string func_str(function);
-        
-
-        bool plotted = false;
-
-        if (!func_str.empty() && func_str.front() == '(' && func_str.back() == ')') {
-          const std::string inner = func_str.substr(1, func_str.size() - 2);
-          // top-level comma separating f and g
-          int depth = 0;
-          size_t split_pos = std::string::npos;
-          for (size_t i = 0; i < inner.size(); ++i) {
-            char c = inner[i];
-            if (c == '(')
-              ++depth;
-            else if (c == ')')
-              --depth;
-            else if (c == ',' && depth == 0) {
-              split_pos = i;
-              break;
-            }
-          }
 
-          if (split_pos != std::string::npos) {
-            std::string fx = trim(inner.substr(0, split_pos));
-            std::string gx = trim(inner.substr(split_pos + 1));
-
-            // Prepare exprtk 
-            double t = 0.0;
-            exprtk::symbol_table<double> sym_t;
-            sym_t.add_constants();
-            addConstants(sym_t);
-            sym_t.add_variable("t", t);
-
-            exprtk::expression<double> expr_fx;
-            expr_fx.register_symbol_table(sym_t);
-            exprtk::expression<double> expr_gx;
-            expr_gx.register_symbol_table(sym_t);
-
-            exprtk::parser<double> parser;
-            bool ok_fx = parser.compile(fx, expr_fx);
-            bool ok_gx = parser.compile(gx, expr_gx);
-
-            if (ok_fx && ok_gx) {
-              // iterate t  
-              const double t_min = -10.0;
-              const double t_max = 10.0;
-              const double t_step = 0.02;  
-
-              for (t = t_min; t <= t_max; t += t_step) {
-                const double vx = expr_fx.value();
-                const double vy = expr_gx.value();
-
-                
-                ImVec2 screen_pos(origin.x + static_cast<float>(vx * zoom),
-                    origin.y - static_cast<float>(vy * zoom));
-                points.push_back(screen_pos);
-              }
-
-              // Draw  curve
-              draw_list->AddPolyline(points.data(),
-                  points.size(),
-                  IM_COL32(64, 128, 199, 255),
-                  ImDrawFlags_None,
-                  lineThickness);
-              plotted = true;
-            }
-          }
+        // Dragging the canvas pans the view
+        ImGui::InvisibleButton(
+            "canvas", ImVec2(std::max(canvas_sz.x, 1.0f), std::max(canvas_sz.y, 1.0f)));
+        if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left, 0.0f)) {
+          center.x -= io.MouseDelta.x / zoom;
+          center.y += io.MouseDelta.y / zoom;
         }
 
-        // check for inequality 
-        if (!plotted && hasInequalityOperator(func_str)) {
-          double x = 0.0, y = 0.0;
-          exprtk::symbol_table<double> symbol_table;
-          symbol_table.add_constants();
-          addConstants(symbol_table);
-          symbol_table.add_variable("x", x);
-          symbol_table.add_variable("y", y);
-          
-          exprtk::expression<double> expression;
-          expression.register_symbol_table(symbol_table);
-          
-          exprtk::parser<double> parser;
-          
-          if (parser.compile(func_str, expression)) {
-            // grid parameters
-            const double x_min = -canvas_sz.x / (2 * zoom);
-            const double x_max = canvas_sz.x / (2 * zoom);
-            const double y_min = -canvas_sz.y / (2 * zoom);
-            const double y_max = canvas_sz.y / (2 * zoom);
-            
-            // adaptive step size with performance limit
-            const double step = std::max(0.025, 1.5 / zoom);
-            const ImU32 inequality_color = IM_COL32(100, 150, 255, 180);
-            const float dot_size = std::max(1.5f, zoom / 60.0f);
-            
-            
-            for (y = y_min; y <= y_max; y += step) {
-              for (x = x_min; x <= x_max; x += step) {
-                
-                // if expression is true, plot the point
-                if (expression.value() == 1.0) {
-                  ImVec2 screen_pos(origin.x + static_cast<float>(x * zoom),
-                                   origin.y - static_cast<float>(y * zoom));
-                  draw_list->AddCircleFilled(screen_pos, dot_size, inequality_color);
-                }
-              }
-            }
-            
-            plotted = true;
-          }
+        // Keeps the newest streamed sample near the right edge
+        if (stream_follow && m_stream_layer->source() != nullptr &&
+            !m_stream_layer->history().empty()) {
+          const auto latest_x = static_cast<float>(m_stream_layer->history().latest().x);
+          center.x = latest_x - canvas_sz.x * 0.4f / zoom;
         }
 
-        // check for implicit form: f(x,y) = g(x,y)
-        if (!plotted) {
-          size_t equals_pos = findTopLevelEquals(func_str);      
-          bool has_double_equals = hasEqualsEqualsOperator(func_str);
-
-          if (equals_pos != std::string::npos || has_double_equals) {
-          
-            std::string implicit_expr;
-
-            if (has_double_equals) {
-              // Handle == operator
-              std::string temp_str = func_str;
-              int depth = 0;
-              size_t eq_pos = std::string::npos;
-              
-              for (size_t i = 0; i < temp_str.size() - 1; ++i) {
-                char c = temp_str[i];
-                if (c == '(') ++depth;
-                else if (c == ')') --depth;
-                else if (depth == 0 && c == '=' && temp_str[i+1] == '=') {
-                  eq_pos = i;
-                  break;
-                }
-              }
-              
-              if (eq_pos != std::string::npos) {
-                std::string lhs = trim(temp_str.substr(0, eq_pos));
-                std::string rhs = trim(temp_str.substr(eq_pos + 2)); // +2 to skip ==
-                implicit_expr = "(" + lhs + ") - (" + rhs + ")";
-              }
-            } else {
-              // Handle = operator
-              std::string lhs = trim(func_str.substr(0, equals_pos));
-              std::string rhs = trim(func_str.substr(equals_pos + 1));
-              implicit_expr = "(" + lhs + ") - (" + rhs + ")";
-            }
+        const ImVec2 origin(canvas_p0.x + canvas_sz.x * 0.5f - center.x * zoom,
+            canvas_p0.y + canvas_sz.y * 0.5f + center.y * zoom);
+        float lineThickness = 6.0f;
 
-            if (!implicit_expr.empty()) {
-              
-            // setup exprtk with x and y variables
-            double x = 0.0, y = 0.0;
-            exprtk::symbol_table<double> symbolTable;
-            symbolTable.add_constants();
-            addConstants(symbolTable);
-            symbolTable.add_variable("x", x);
-            symbolTable.add_variable("y", y);
-            
-            exprtk::expression<double> expression;
-            expression.register_symbol_table(symbolTable);
-            
-            exprtk::parser<double> parser;
-            bool compile_ok = parser.compile(implicit_expr, expression);
-            
-            if (compile_ok) {
-              // grid parameters
-              const double x_min = -canvas_sz.x / (2 * zoom);
-              const double x_max = canvas_sz.x / (2 * zoom);
-              const double y_min = -canvas_sz.y / (2 * zoom);
-              const double y_max = canvas_sz.y / (2 * zoom);
-              const double step = std::max(0.008, 1.0 / zoom); //dynamic step based on zoom level
-              
-              const ImU32 implicit_color = IM_COL32(64, 199, 128, 255);
-              const float dot_radius = 2.5f;
-              
-              // scan horizontally for sign changes
-              for (y = y_min; y <= y_max; y += step) {
-                double prev_val = 0.0;
-                bool first = true;
-                
-                for (x = x_min; x <= x_max; x += step) {
-                  double curr_val = expression.value();
-                  
-                  if (!first && prev_val * curr_val < 0) {
-                    // sign change detected
-                    double t = prev_val / (prev_val - curr_val);
-                    double x_zero = (x - step) + t * step;
-                    double y_zero = y;
-                    
-                    // transform to screen coordinates and draw immediately
-                    ImVec2 screen_pos(origin.x + static_cast<float>(x_zero * zoom),
-                                     origin.y - static_cast<float>(y_zero * zoom));
-                    draw_list->AddCircleFilled(screen_pos, dot_radius, implicit_color);
-                  }
-                  
-                  prev_val = curr_val;
-                  first = false;
-                }
-              }
-              
-              // vertical scan
-              for (x = x_min; x <= x_max; x += step) {
-                double prev_val = 0.0;
-                bool first = true;
-                
-                for (y = y_min; y <= y_max; y += step) {
-                  double curr_val = expression.value();
-                  
-                  if (!first && prev_val * curr_val < 0) {
-                    // sign change detected
-                    double t = prev_val / (prev_val - curr_val);
-                    double x_zero = x;
-                    double y_zero = (y - step) + t * step;
-        
-                    ImVec2 screen_pos(origin.x + static_cast<float>(x_zero * zoom),
-                                     origin.y - static_cast<float>(y_zero * zoom));
-                    draw_list->AddCircleFilled(screen_pos, dot_radius, implicit_color);
-                  }
-                  
-                  prev_val = curr_val;
-                  first = false;
-                }
-              }
-              
-                plotted = true;
-              }
-            }
+        // Plots are evaluated in the background; the last completed one is drawn until then.
+        // Hidden layers are not submitted, so they are not evaluated again either
+        const Plot::PlotView view{
+            zoom, canvas_sz, center, static_cast<Plot::ImplicitEngine>(implicit_engine)};
+        for (const auto& layer : m_expression_layers) {
+          if (layer->visible) {
+            // A layer only gets a new request when a parameter it reads moved
+            m_plot_evaluator->submit(layer->id, layer->text.data(), layer->parameter_values, view);
+            layer->plot.update(*m_plot_evaluator, layer->id);
           }
         }
 
-        if (!plotted) {
-          std::string func_str(function);
-          bool is_polar = func_str.find("r=") != std::string::npos || func_str.find("r =") != std::string::npos;
-
-          if (is_polar) {
-            double theta;
-
-            exprtk::symbol_table<double> symbolTable;
-            symbolTable.add_constants();
-            addConstants(symbolTable);
-            symbolTable.add_variable("theta", theta);
-
-            exprtk::expression<double> expression;
-            expression.register_symbol_table(symbolTable);
-
-            std::string polar_function = func_str;
-            size_t eq_pos = func_str.find("r=");
-            if (eq_pos == std::string::npos) {
-              eq_pos = func_str.find("r =");
-            }
-            if (eq_pos != std::string::npos) {
-              size_t start_pos = func_str.find("=", eq_pos) + 1;
-              polar_function = func_str.substr(start_pos);
-              polar_function.erase(0, polar_function.find_first_not_of(" \t"));
-            }
-
-            exprtk::parser<double> parser;
-            if (parser.compile(polar_function, expression)) {
-              const double theta_min = 0.0;
-              const double theta_max = 4.0 * M_PI;  
-              const double theta_step = 0.02;
-
-              for (theta = theta_min; theta <= theta_max; theta += theta_step) {
-                const double r = expression.value();
-                
-                const double x = r * cos(theta);
-                const double y = r * sin(theta);
-
-                ImVec2 screen_pos(origin.x + static_cast<float>(x * zoom),
-                    origin.y - static_cast<float>(y * zoom));
-                points.push_back(screen_pos);
-              }
-
-              draw_list->AddPolyline(points.data(),
-                  points.size(),
-                  IM_COL32(128, 64, 199, 255),
-                  ImDrawFlags_None,
-                  lineThickness);
+        // Each layer is only drawn again when it or the view changed, otherwise its texture
+        // from an earlier frame is composited
+        const Plot::CanvasView canvas{canvas_p0, canvas_p1, origin, zoom};
+        const auto draw_axes = [lineThickness](ImDrawList* layer,
+            const Plot::CanvasView& layer_view) {
+          Plot::draw_axes(layer,
+              layer_view.min,
+              layer_view.max,
+              layer_view.origin,
+              layer_view.zoom,
+              lineThickness);
+        };
+        const auto draw_expression = [this, lineThickness](ExpressionLayer& expression,
+            ImDrawList* layer,
+            const Plot::CanvasView& layer_view) {
+          expression.plot.draw(
+              layer, layer_view.origin, layer_view.zoom, lineThickness, *m_frame_arena);
+        };
+        const auto draw_overflow = [this, &draw_expression](ImDrawList* layer,
+            const Plot::CanvasView& layer_view) {
+          for (std::size_t i = max_layer_textures; i < m_expression_layers.size(); ++i) {
+            if (m_expression_layers[i]->visible) {
+              draw_expression(*m_expression_layers[i], layer, layer_view);
             }
+          }
+        };
+        const auto draw_data = [this, lineThickness](ImDrawList* layer,
+            const Plot::CanvasView& layer_view) {
+          m_data_layer->draw(layer,
+              layer_view.min,
+              layer_view.max,
+              layer_view.origin,
+              layer_view.zoom,
+              lineThickness * 0.5f,
+              *m_frame_arena);
+        };
+        const auto draw_stream = [this, lineThickness](ImDrawList* layer,
+            const Plot::CanvasView& layer_view) {
+          m_stream_layer->draw(layer,
+              layer_view.min,
+              layer_view.max,
+              layer_view.origin,
+              layer_view.zoom,
+              lineThickness * 0.5f,
+              *m_frame_arena);
+        };
+        m_axes_cache->draw(draw_list, canvas, 0, draw_axes);
+        // One animated parameter only redraws the layers that read it. Layers past the
+        // texture cap share one, which any change to one of them redraws as a whole.
+        std::uint64_t overflow_revision = 0;
+        bool overflow_visible = false;
+        for (std::size_t i = 0; i < m_expression_layers.size(); ++i) {
+          ExpressionLayer& expression = *m_expression_layers[i];
+          if (!expression.visible) {
+            continue;
+          }
+          if (i < max_layer_textures) {
+            expression.cache.draw(draw_list,
+                canvas,
+                expression.plot.revision(),
+                [&draw_expression, &expression](
+                    ImDrawList* layer, const Plot::CanvasView& layer_view) {
+                  draw_expression(expression, layer, layer_view);
+                });
           } else {
-            double x;
-
-            exprtk::symbol_table<double> symbolTable;
-            symbolTable.add_constants();
-            addConstants(symbolTable);
-            symbolTable.add_variable("x", x);
-
-            exprtk::expression<double> expression;
-            expression.register_symbol_table(symbolTable);
-
-            exprtk::parser<double> parser;
-            parser.compile(function, expression);
-
-            for (x = -canvas_sz.x / (2 * zoom); x < canvas_sz.x / (2 * zoom); x += 0.05) {
-              const double y = expression.value();
-
-              ImVec2 screen_pos(origin.x + x * zoom, origin.y - y * zoom);
-              points.push_back(screen_pos);
-            }
-
-            draw_list->AddPolyline(points.data(),
-                points.size(),
-                IM_COL32(199, 68, 64, 255),
-                ImDrawFlags_None,
-                lineThickness);
+            overflow_revision = combine(combine(overflow_revision, expression.id),
+                expression.plot.revision());
+            overflow_visible = true;
           }
         }
+        if (overflow_visible) {
+          m_overflow_cache->draw(draw_list, canvas, overflow_revision, draw_overflow);
+        }
+        m_data_cache->draw(draw_list, canvas, m_data_layer->revision(), draw_data);
+        m_stream_cache->draw(draw_list, canvas, m_stream_layer->revision(), draw_stream);
 
         ImGui::End();
         ImGui::PopStyleColor();
       }
     }
 
+    if (m_show_debug_panel) {
+      m_performance_panel->draw(&m_show_debug_panel);
+    }
+
     // Rendering
     ImGui::Render();
+    draw_list_timer.stop();
+    m_performance_panel->end_frame(ImGui::GetDrawData());
 
+    APP_PROFILE_STAGE(Debug::Stage::Render, "Render");
     SDL_RenderSetScale(m_window->get_native_renderer(),
         io.DisplayFramebufferScale.x,
         io.DisplayFramebufferScale.y);
@@ -548,4 +586,97 @@ void Application::on_close() {
   stop();
 }
 
+void Application::add_expression_layer(const char* text) {
+  const std::uint64_t id = m_next_layer_id++;
+  const ImU32 color = layer_colors[(id - 1) % layer_colors.size()];
+  m_expression_layers.push_back(
+      std::make_unique<ExpressionLayer>(id, m_window->get_native_renderer(), text, color));
+}
+
+void Application::update_parameters() {
+  for (Parameter& parameter : m_parameters) {
+    parameter.used = false;
+  }
+
+  const auto find = [this](const std::string& name) {
+    return std::lower_bound(m_parameters.begin(),
+        m_parameters.end(),
+        name,
+        [](const Parameter& parameter, const std::string& key) { return parameter.name < key; });
+  };
+
+  for (const auto& layer : m_expression_layers) {
+    if (layer->described_text != layer->text.data()) {
+      layer->described_text = layer->text.data();
+      layer->description = Plot::describe_plot(layer->described_text);
+    }
+    for (const std::string& name : layer->description.parameters) {
+      auto parameter = find(name);
+      if (parameter == m_parameters.end() || parameter->name != name) {
+        Parameter added;
+        added.name = name;
+        added.value = static_cast<float>(Plot::default_parameter_value);
+        parameter = m_parameters.insert(parameter, std::move(added));
+      }
+      parameter->used = true;
+    }
+  }
+
+  bool animating = false;
+  const bool any_used = std::any_of(m_parameters.begin(),
+      m_parameters.end(),
+      [](const Parameter& parameter) { return parameter.used; });
+  if (any_used) {
+    ImGui::SeparatorText("Parameters");
+  }
+  for (Parameter& parameter : m_parameters) {
+    if (!parameter.used) {
+      continue;
+    }
+
+    ImGui::PushID(parameter.name.c_str());
+    ImGui::Checkbox("##animate", &parameter.animate);
+    ImGui::SameLine();
+    ImGui::SliderFloat(parameter.name.c_str(), &parameter.value, parameter.min, parameter.max);
+
+    // Sweeps the range back and forth in four seconds
+    if (parameter.animate && parameter.max > parameter.min) {
+      const float range = parameter.max - parameter.min;
+      parameter.value += parameter.direction * range * 0.25f * ImGui::GetIO().DeltaTime;
+      if (parameter.value >= parameter.max || parameter.value <= parameter.min) {
+        parameter.value = std::clamp(parameter.value, parameter.min, parameter.max);
+        parameter.direction = -parameter.direction;
+      }
+      animating = true;
+    }
+    ImGui::PopID();
+  }
+
+  // An animation has to keep drawing frames without any input
+  if (animating) {
+    m_frames_to_render = std::max(m_frames_to_render, 1);
+  }
+
+  for (const auto& layer : m_expression_layers) {
+    layer->parameter_values.clear();
+    for (const std::string& name : layer->description.parameters) {
+      layer->parameter_values.push_back(static_cast<double>(find(name)->value));
+    }
+  }
+}
+
+void Application::on_render_reset() {
+  APP_PROFILE_FUNCTION();
+
+  // The renderer lost what the layer textures held, or the textures themselves
+  m_axes_cache->reset();
+  m_overflow_cache->reset();
+  m_data_cache->reset();
+  m_stream_cache->reset();
+  for (const auto& expression : m_expression_layers) {
+    expression->cache.reset();
+    expression->plot.on_render_reset();
+  }
+}
+
 }  // namespace App
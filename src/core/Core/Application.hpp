@@ -2,6 +2,7 @@
 
 #include <SDL2/SDL.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -10,6 +11,19 @@
 
 namespace App {
 
+class FrameArena;
+
+namespace Debug {
+class PerformancePanel;
+}  // namespace Debug
+
+namespace Plot {
+class DataLayer;
+class LayerCache;
+class PlotEvaluator;
+class StreamLayer;
+}  // namespace Plot
+
 enum class ExitStatus : int { SUCCESS = 0, FAILURE = 1 };
 
 class Application {
@@ -29,13 +43,54 @@ class Application {
   void on_minimize();
   void on_shown();
   void on_close();
+  void on_render_reset();
 
  private:
+  struct ExpressionLayer;
+
+  // A free variable of the expressions, bound to a slider. Kept when no expression reads
+  // it any more, so retyping the name brings its value back.
+  struct Parameter {
+    std::string name;
+    float value{1.0F};
+    float min{-10.0F};
+    float max{10.0F};
+    bool animate{false};
+    // +1 or -1, the direction an animation currently moves the value in
+    float direction{1.0F};
+    // Whether an expression read it in the current frame
+    bool used{false};
+  };
+
+  void add_expression_layer(const char* text);
+  // Finds the parameters of the expressions, draws their sliders and advances their
+  // animations, then gathers the values each expression layer reads.
+  void update_parameters();
+
   ExitStatus m_exit_status{ExitStatus::SUCCESS};
   std::unique_ptr<Window> m_window{nullptr};
+  std::unique_ptr<Plot::PlotEvaluator> m_plot_evaluator{nullptr};
+  std::unique_ptr<Plot::DataLayer> m_data_layer{nullptr};
+  std::unique_ptr<Plot::StreamLayer> m_stream_layer{nullptr};
+  std::unique_ptr<Plot::LayerCache> m_axes_cache{nullptr};
+  // Expression layers past the texture cap, drawn together
+  std::unique_ptr<Plot::LayerCache> m_overflow_cache{nullptr};
+  std::unique_ptr<Plot::LayerCache> m_data_cache{nullptr};
+  std::unique_ptr<Plot::LayerCache> m_stream_cache{nullptr};
+  std::unique_ptr<Debug::PerformancePanel> m_performance_panel{nullptr};
+  // Scratch for drawing the layers, reset at the start of every frame
+  std::unique_ptr<FrameArena> m_frame_arena{nullptr};
+
+  std::vector<std::unique_ptr<ExpressionLayer>> m_expression_layers;
+  std::uint64_t m_next_layer_id{1};
+  // Sorted by name
+  std::vector<Parameter> m_parameters;
 
   bool m_running{true};
   bool m_minimized{false};
+  bool m_power_saving{true};
+  int m_frames_to_render{1};
+  std::uint32_t m_wake_event{0};
   bool m_show_some_panel{true};
   bool m_show_debug_panel{false};
   bool m_show_demo_panel{false};
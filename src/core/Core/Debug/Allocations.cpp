@@ -0,0 +1,95 @@
+#include "Allocations.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+
+void* counted_allocate(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+
+  // operator new must return a unique pointer even for zero bytes
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    if (void* memory = std::malloc(size)) {
+      return memory;
+    }
+    const std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void* counted_allocate(std::size_t size, const std::nothrow_t& /*unused*/) noexcept {
+  try {
+    return counted_allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+}  // namespace
+
+namespace App::Debug {
+
+std::uint64_t allocation_count() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+}  // namespace App::Debug
+
+// The over-aligned variants are left to the standard library; they pair with their own
+// delete overloads, so memory never crosses between the two.
+
+void* operator new(std::size_t size) {
+  return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return counted_allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+  return counted_allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return counted_allocate(size, tag);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t /*size*/) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t /*size*/) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t& /*unused*/) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t& /*unused*/) noexcept {
+  std::free(memory);
+}
+
+// NOLINTEND(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace App::Debug {
+
+// Calls of the global operator new on any thread since the process started. Linking this
+// in replaces the global allocation functions with counting ones that forward to malloc.
+[[nodiscard]] std::uint64_t allocation_count();
+
+}  // namespace App::Debug
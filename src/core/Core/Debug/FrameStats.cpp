@@ -0,0 +1,70 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace App::Debug {
+
+namespace {
+
+// Nearest-rank percentile of sorted `values`
+float percentile(const std::vector<float>& values, float fraction) {
+  const auto rank = static_cast<std::size_t>(fraction * static_cast<float>(values.size() - 1));
+  return values[std::min(rank, values.size() - 1)];
+}
+
+}  // namespace
+
+void RollingSeries::add(float value) {
+  const std::uint64_t index = m_written.load(std::memory_order_relaxed);
+  m_values[index % capacity].store(value, std::memory_order_relaxed);
+  m_written.store(index + 1, std::memory_order_release);
+}
+
+void RollingSeries::snapshot(std::vector<float>& out) const {
+  const std::uint64_t written = m_written.load(std::memory_order_acquire);
+  const std::uint64_t first = written > capacity ? written - capacity : 0;
+
+  out.clear();
+  for (std::uint64_t i = first; i < written; ++i) {
+    out.push_back(m_values[i % capacity].load(std::memory_order_relaxed));
+  }
+}
+
+RollingSeries::Summary RollingSeries::summary(std::vector<float>& scratch) const {
+  snapshot(scratch);
+  if (scratch.empty()) {
+    return {};
+  }
+
+  Summary summary;
+  summary.last = scratch.back();
+  summary.count = scratch.size();
+
+  std::sort(scratch.begin(), scratch.end());
+  summary.p50 = percentile(scratch, 0.50F);
+  summary.p95 = percentile(scratch, 0.95F);
+  summary.p99 = percentile(scratch, 0.99F);
+  return summary;
+}
+
+void FrameStats::add(Stage stage, float milliseconds) {
+  m_stages[static_cast<std::size_t>(stage)].add(milliseconds);
+}
+
+const RollingSeries& FrameStats::stage(Stage stage) const {
+  return m_stages[static_cast<std::size_t>(stage)];
+}
+
+void FrameStats::add_evaluations(std::uint64_t count) {
+  m_evaluations.fetch_add(count, std::memory_order_relaxed);
+}
+
+std::uint64_t FrameStats::evaluations() const {
+  return m_evaluations.load(std::memory_order_relaxed);
+}
+
+}  // namespace App::Debug
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+
+namespace App::Debug {
+
+// The parts of a frame the performance panel breaks timings down by. Compile and
+// Evaluation run on the plot evaluator's thread, the others on the main thread.
+enum class Stage : std::uint8_t { Frame, EventPolling, Compile, Evaluation, DrawList, Render };
+inline constexpr std::size_t stage_count = 6;
+
+// The last `capacity` values of a series, e.g. a stage's durations in milliseconds. Each
+// series has a single writing thread; any thread can read a snapshot without locking,
+// which at worst misses the values written meanwhile.
+class RollingSeries {
+ public:
+  static constexpr std::size_t capacity = 256;
+
+  struct Summary {
+    float p50{0.0F};
+    float p95{0.0F};
+    float p99{0.0F};
+    float last{0.0F};
+    std::size_t count{0};
+  };
+
+  void add(float value);
+  // Copies the stored values, oldest first, into `out`.
+  void snapshot(std::vector<float>& out) const;
+  // Percentiles of the stored values; `scratch` avoids an allocation per call.
+  [[nodiscard]] Summary summary(std::vector<float>& scratch) const;
+
+ private:
+  std::array<std::atomic<float>, capacity> m_values{};
+  std::atomic<std::uint64_t> m_written{0};
+};
+
+// Process-wide timings and counters for the performance panel. Unlike the Instrumentor
+// this is always on: recording a value costs a few relaxed atomic operations.
+class FrameStats {
+ public:
+  FrameStats(const FrameStats&) = delete;
+  FrameStats(FrameStats&&) = delete;
+  FrameStats& operator=(FrameStats other) = delete;
+  FrameStats& operator=(FrameStats&& other) = delete;
+
+  void add(Stage stage, float milliseconds);
+  [[nodiscard]] const RollingSeries& stage(Stage stage) const;
+
+  void add_evaluations(std::uint64_t count);
+  // Point evaluations made since the process started.
+  [[nodiscard]] std::uint64_t evaluations() const;
+
+  static FrameStats& get() {
+    static FrameStats instance;
+    return instance;
+  }
+
+ private:
+  FrameStats() = default;
+  ~FrameStats() = default;
+
+  std::array<RollingSeries, stage_count> m_stages;
+  std::atomic<std::uint64_t> m_evaluations{0};
+};
+
+// Adds the time from construction to stop() or destruction to a stage.
+class StageTimer {
+ public:
+  explicit StageTimer(Stage stage) : m_stage(stage), m_start(std::chrono::steady_clock::now()) {}
+
+  StageTimer(const StageTimer&) = delete;
+  StageTimer(StageTimer&&) = delete;
+  StageTimer& operator=(StageTimer other) = delete;
+  StageTimer& operator=(StageTimer&& other) = delete;
+
+  ~StageTimer() {
+    if (!m_stopped) {
+      stop();
+    }
+  }
+
+  void stop() {
+    const std::chrono::duration<float, std::milli> elapsed =
+        std::chrono::steady_clock::now() - m_start;
+    FrameStats::get().add(m_stage, elapsed.count());
+    m_stopped = true;
+  }
+
+ private:
+  Stage m_stage;
+  bool m_stopped{false};
+  const std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace App::Debug
+
+#define APP_STAGE_JOIN_AGAIN(x, y) x##y
+#define APP_STAGE_JOIN(x, y) APP_STAGE_JOIN_AGAIN(x, y)
+
+// Times the rest of the scope for the performance panel and, when profiling is enabled,
+// records it as a profiler scope called `name` as well.
+#define APP_PROFILE_STAGE(stage, name)                                              \
+  const ::App::Debug::StageTimer APP_STAGE_JOIN(stage_timer, __LINE__){stage}; \
+  APP_PROFILE_SCOPE(name)
@@ -0,0 +1,209 @@
+#include "Instrumentor.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "Core/Log.hpp"
+
+namespace App::Debug {
+
+namespace {
+
+// How often recorded events are moved from the thread buffers to the file. At the
+// buffer capacity this allows for about 800k events per second and thread.
+constexpr auto drain_interval = std::chrono::milliseconds(20);
+
+}  // namespace
+
+struct Instrumentor::ThreadBuffer {
+  ThreadBuffer() = default;
+  ~ThreadBuffer() {
+    if (buffer != nullptr) {
+      Instrumentor::get().release_buffer(*buffer);
+    }
+  }
+
+  ThreadBuffer(const ThreadBuffer&) = delete;
+  ThreadBuffer(ThreadBuffer&&) = delete;
+  ThreadBuffer& operator=(ThreadBuffer other) = delete;
+  ThreadBuffer& operator=(ThreadBuffer&& other) = delete;
+
+  ProfileEventBuffer* buffer{nullptr};
+};
+
+Instrumentor::~Instrumentor() {
+  end_session();
+}
+
+void Instrumentor::begin_session(const std::string& name, const std::string& filepath) {
+  stop_drain_thread();
+
+  {
+    const std::lock_guard lock(m_mutex);
+
+    if (m_current_session != nullptr) {
+      // If there is already a current session, then close it before beginning new one.
+      // Subsequent profiling output meant for the original session will end up in the
+      // newly opened session instead.  That's better than having badly formatted
+      // profiling output.
+      APP_ERROR("Instrumentor::begin_session('{0}') when session '{1}' already open.",
+          name,
+          m_current_session->name);
+      internal_end_session();
+    }
+    m_output_stream.open(filepath);
+
+    if (!m_output_stream.is_open()) {
+      APP_ERROR("Instrumentor could not open results file '{0}'.", filepath);
+      return;
+    }
+
+    m_current_session = std::make_unique<InstrumentationSession>(name);
+    m_output_stream << R"({"otherData": {},"traceEvents":[{})";
+
+    // Whatever was left over from before the session does not belong to it
+    const std::lock_guard buffers_lock(m_buffers_mutex);
+    for (const auto& buffer : m_buffers) {
+      buffer->drain([](const ProfileEvent&) {});
+      buffer->take_dropped();
+    }
+    m_released_dropped = 0;
+  }
+
+  m_recording.store(true, std::memory_order_relaxed);
+  start_drain_thread();
+}
+
+void Instrumentor::end_session() {
+  m_recording.store(false, std::memory_order_relaxed);
+  stop_drain_thread();
+
+  const std::lock_guard lock(m_mutex);
+  internal_end_session();
+}
+
+std::size_t Instrumentor::thread_buffer_count() {
+  const std::lock_guard lock(m_buffers_mutex);
+  return m_buffers.size();
+}
+
+ProfileEventBuffer& Instrumentor::thread_buffer() {
+  thread_local ThreadBuffer owner;
+  if (owner.buffer == nullptr) {
+    const std::lock_guard lock(m_buffers_mutex);
+    m_buffers.push_back(std::make_unique<ProfileEventBuffer>(m_next_thread_index++));
+    owner.buffer = m_buffers.back().get();
+  }
+  return *owner.buffer;
+}
+
+void Instrumentor::release_buffer(const ProfileEventBuffer& buffer) {
+  // Holding m_mutex keeps the drain thread away, so nothing reads the buffer once it is
+  // freed; the early drain writes out the thread's last events first
+  const std::lock_guard lock(m_mutex);
+  drain();
+
+  const std::lock_guard buffers_lock(m_buffers_mutex);
+  const auto owned = std::find_if(m_buffers.begin(), m_buffers.end(), [&buffer](const auto& b) {
+    return b.get() == &buffer;
+  });
+  if (owned != m_buffers.end()) {
+    m_released_dropped += (*owned)->take_dropped();
+    m_buffers.erase(owned);
+  }
+}
+
+void Instrumentor::start_drain_thread() {
+  m_drain_thread = std::thread([this] { drain_loop(); });
+}
+
+void Instrumentor::stop_drain_thread() {
+  if (!m_drain_thread.joinable()) {
+    return;
+  }
+
+  {
+    const std::lock_guard lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_drain_thread.join();
+  m_stopping = false;
+}
+
+void Instrumentor::drain_loop() {
+  std::unique_lock lock(m_mutex);
+  while (!m_stopping) {
+    m_wake.wait_for(lock, drain_interval, [this] { return m_stopping; });
+    drain();
+  }
+}
+
+void Instrumentor::drain() {
+  if (m_current_session == nullptr) {
+    return;
+  }
+
+  // Threads register rarely, so only the list of buffers is taken under the lock
+  {
+    const std::lock_guard lock(m_buffers_mutex);
+    m_drain_buffers.clear();
+    for (const auto& buffer : m_buffers) {
+      m_drain_buffers.push_back(buffer.get());
+    }
+  }
+
+  m_drain_text.clear();
+  auto out = std::back_inserter(m_drain_text);
+  for (ProfileEventBuffer* buffer : m_drain_buffers) {
+    const std::uint32_t thread = buffer->thread_index();
+    buffer->drain([&out, thread](const ProfileEvent& event) {
+      out = fmt::format_to(out, R"(,{{"cat":"function","dur":{:.3f},"name":")",
+          static_cast<double>(event.end - event.start) / 1000.0);
+      for (const char* c = event.name; *c != '\0'; ++c) {
+        *out++ = *c == '"' ? '\'' : *c == '\\' ? '/' : *c;
+      }
+      out = fmt::format_to(out, R"(","ph":"X","pid":0,"tid":{},"ts":{:.3f}}})",
+          thread,
+          static_cast<double>(event.start) / 1000.0);
+    });
+  }
+  m_output_stream << m_drain_text;
+}
+
+void Instrumentor::internal_end_session() {
+  if (m_current_session == nullptr) {
+    return;
+  }
+
+  drain();
+
+  std::uint64_t dropped = 0;
+  {
+    const std::lock_guard lock(m_buffers_mutex);
+    dropped = std::exchange(m_released_dropped, 0);
+    for (const auto& buffer : m_buffers) {
+      dropped += buffer->take_dropped();
+    }
+  }
+  if (dropped > 0) {
+    APP_WARN("Instrumentor dropped {} events of session '{}', the drain fell behind.",
+        dropped,
+        m_current_session->name);
+  }
+
+  m_output_stream << "]}";
+  m_output_stream.close();
+  m_current_session.reset();
+}
+
+}  // namespace App::Debug
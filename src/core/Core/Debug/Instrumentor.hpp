@@ -1,25 +1,74 @@
 #pragma once
 
-#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
-#include "Core/Log.hpp"
+#include "Core/SpscRing.hpp"
 
 namespace App::Debug {
 
-using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
+// One finished scope, timed in steady clock nanoseconds. The name is not copied: it has
+// to outlive the session, which the string literals passed by the profiling macros do.
+struct ProfileEvent {
+  const char* name{nullptr};
+  std::int64_t start{0};
+  std::int64_t end{0};
+};
+
+// The events of one thread, written only by that thread and read only by the thread
+// draining the session. Pushing neither locks nor allocates; when the ring is full the
+// event is counted as dropped instead.
+class ProfileEventBuffer {
+ public:
+  static constexpr std::size_t capacity = 16384;
+
+  explicit ProfileEventBuffer(std::uint32_t thread_index)
+      : m_events(capacity),
+        m_thread_index(thread_index) {}
+
+  ProfileEventBuffer(const ProfileEventBuffer&) = delete;
+  ProfileEventBuffer(ProfileEventBuffer&&) = delete;
+  ProfileEventBuffer& operator=(ProfileEventBuffer other) = delete;
+  ProfileEventBuffer& operator=(ProfileEventBuffer&& other) = delete;
+  ~ProfileEventBuffer() = default;
+
+  bool push(const ProfileEvent& event) {
+    if (!m_events.push(event)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  // Hands every event pushed so far to `sink` in order and frees their slots.
+  template <typename Sink>
+  std::size_t drain(Sink&& sink) {
+    return m_events.drain(std::forward<Sink>(sink));
+  }
 
-struct ProfileResult {
-  std::string name;
-  FloatingPointMicroseconds start;
-  std::chrono::microseconds elapsed_time;
-  std::thread::id thread_id;
+  [[nodiscard]] std::uint32_t thread_index() const {
+    return m_thread_index;
+  }
+
+  // Events lost to a full ring since the last call.
+  std::uint64_t take_dropped() {
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+ private:
+  SpscRing<ProfileEvent> m_events;
+  std::atomic<std::uint64_t> m_dropped{0};
+  std::uint32_t m_thread_index;
 };
 
 struct InstrumentationSession {
@@ -27,6 +76,10 @@ struct InstrumentationSession {
   explicit InstrumentationSession(std::string session_name) : name(std::move(session_name)) {}
 };
 
+// Records profiled scopes into per-thread ProfileEventBuffers while a session is open. A
+// background thread drains them periodically and appends the events to the session file
+// in the Chrome trace event format, so recording a scope costs two clock reads and a push.
+// A thread's buffer is drained one last time and freed when the thread exits.
 class Instrumentor {
  public:
   Instrumentor(const Instrumentor&) = delete;
@@ -34,55 +87,12 @@ class Instrumentor {
   Instrumentor& operator=(Instrumentor other) = delete;
   Instrumentor& operator=(Instrumentor&& other) = delete;
 
-  void begin_session(const std::string& name, const std::string& filepath = "results.json") {
-    const std::lock_guard lock(m_mutex);
-
-    if (m_current_session != nullptr) {
-      // If there is already a current session, then close it before beginning new one.
-      // Subsequent profiling output meant for the original session will end up in the
-      // newly opened session instead.  That's better than having badly formatted
-      // profiling output.
-      APP_ERROR("Instrumentor::begin_session('{0}') when session '{1}' already open.",
-          name,
-          m_current_session->name);
-      internal_end_session();
-    }
-    m_output_stream.open(filepath);
-
-    if (m_output_stream.is_open()) {
-      m_current_session = std::make_unique<InstrumentationSession>(name);
-      write_header();
-    } else {
-      APP_ERROR("Instrumentor could not open results file '{0}'.", filepath);
-    }
-  }
-
-  void end_session() {
-    const std::lock_guard lock(m_mutex);
-    internal_end_session();
-  }
+  void begin_session(const std::string& name, const std::string& filepath = "results.json");
+  void end_session();
 
-  void write_profile(const ProfileResult& result) {
-    std::stringstream json;
-
-    std::string name{result.name};
-    std::replace(name.begin(), name.end(), '"', '\'');
-
-    json << std::setprecision(3) << std::fixed;
-    json << ",{";
-    json << R"("cat":"function",)";
-    json << "\"dur\":" << (result.elapsed_time.count()) << ',';
-    json << R"("name":")" << name << "\",";
-    json << R"("ph":"X",)";
-    json << "\"pid\":0,";
-    json << R"("tid":")" << result.thread_id << "\",";
-    json << "\"ts\":" << result.start.count();
-    json << "}";
-
-    const std::lock_guard lock(m_mutex);
-    if (m_current_session != nullptr) {
-      m_output_stream << json.str();
-      m_output_stream.flush();
+  void record(const char* name, std::int64_t start, std::int64_t end) {
+    if (m_recording.load(std::memory_order_relaxed)) {
+      thread_buffer().push({name, start, end});
     }
   }
 
@@ -91,42 +101,51 @@ class Instrumentor {
     return instance;
   }
 
+  // Buffers of the threads that recorded an event and have not exited yet.
+  [[nodiscard]] std::size_t thread_buffer_count();
+
  private:
-  Instrumentor() : m_current_session(nullptr) {}
+  // Owns the buffer of one thread and releases it when the thread exits
+  struct ThreadBuffer;
 
-  ~Instrumentor() {
-    end_session();
-  }
+  Instrumentor() = default;
+  ~Instrumentor();
 
-  void write_header() {
-    m_output_stream << R"({"otherData": {},"traceEvents":[{})";
-    m_output_stream.flush();
-  }
+  // The calling thread's buffer, registered on its first event.
+  ProfileEventBuffer& thread_buffer();
+  // Drains the buffer of an exiting thread and frees it.
+  void release_buffer(const ProfileEventBuffer& buffer);
 
-  void write_footer() {
-    m_output_stream << "]}";
-    m_output_stream.flush();
-  }
+  void start_drain_thread();
+  void stop_drain_thread();
+  void drain_loop();
 
-  // Note: you must already own lock on m_Mutex before
-  // calling InternalEndSession()
-  void internal_end_session() {
-    if (m_current_session != nullptr) {
-      write_footer();
-      m_output_stream.close();
-    }
-  }
+  // Note: you must already own lock on m_mutex before calling these
+  void drain();
+  void internal_end_session();
 
   std::mutex m_mutex;
   std::unique_ptr<InstrumentationSession> m_current_session;
   std::ofstream m_output_stream;
+  std::atomic<bool> m_recording{false};
+
+  std::mutex m_buffers_mutex;
+  std::vector<std::unique_ptr<ProfileEventBuffer>> m_buffers;
+  // Thread indices are not reused, so the threads of a trace stay apart
+  std::uint32_t m_next_thread_index{0};
+  // Events dropped by the buffers released since the session began
+  std::uint64_t m_released_dropped{0};
+  std::vector<ProfileEventBuffer*> m_drain_buffers;
+  std::string m_drain_text;
+
+  std::condition_variable m_wake;
+  bool m_stopping{false};
+  std::thread m_drain_thread;
 };
 
 class InstrumentationTimer {
  public:
-  explicit InstrumentationTimer(std::string name)
-      : m_name(std::move(name)),
-        m_start_time_point(std::chrono::steady_clock::now()) {}
+  explicit InstrumentationTimer(const char* name) : m_name(name), m_start(now()) {}
 
   InstrumentationTimer(const InstrumentationTimer&) = delete;
   InstrumentationTimer(InstrumentationTimer&&) = delete;
@@ -140,23 +159,20 @@ class InstrumentationTimer {
   }
 
   void stop() {
-    const auto end_time_point{std::chrono::steady_clock::now()};
-    const auto high_res_start{FloatingPointMicroseconds{m_start_time_point.time_since_epoch()}};
-    const auto elapsed_time{
-        std::chrono::time_point_cast<std::chrono::microseconds>(end_time_point).time_since_epoch() -
-        std::chrono::time_point_cast<std::chrono::microseconds>(m_start_time_point)
-            .time_since_epoch()};
-
-    Instrumentor::get().write_profile(
-        {m_name, high_res_start, elapsed_time, std::this_thread::get_id()});
-
+    Instrumentor::get().record(m_name, m_start, now());
     m_stopped = true;
   }
 
  private:
-  const std::string m_name;
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  const char* m_name;
   bool m_stopped{false};
-  const std::chrono::time_point<std::chrono::steady_clock> m_start_time_point;
+  const std::int64_t m_start;
 };
 
 }  // namespace App::Debug
@@ -0,0 +1,95 @@
+#include "PerformancePanel.hpp"
+
+#include <imgui.h>
+
+#include <array>
+#include <cstdint>
+
+#include "Core/Debug/Allocations.hpp"
+#include "Core/Debug/FrameStats.hpp"
+#include "Core/Debug/Instrumentor.hpp"
+
+namespace App::Debug {
+
+namespace {
+
+struct StageLabel {
+  Stage stage;
+  const char* label;
+};
+
+constexpr std::array<StageLabel, stage_count> stage_labels{{
+    {Stage::Frame, "Frame"},
+    {Stage::EventPolling, "Event polling"},
+    {Stage::Compile, "Expression compile"},
+    {Stage::Evaluation, "Evaluation"},
+    {Stage::DrawList, "Draw list build"},
+    {Stage::Render, "Render and present"},
+}};
+
+constexpr float histogram_height = 40.0F;
+
+}  // namespace
+
+void PerformancePanel::end_frame(const ImDrawData* draw_data) {
+  const std::uint64_t evaluations = FrameStats::get().evaluations();
+  const std::uint64_t allocations = allocation_count();
+  m_evaluations.add(static_cast<float>(evaluations - m_last_evaluations));
+  m_allocations.add(static_cast<float>(allocations - m_last_allocations));
+  m_last_evaluations = evaluations;
+  m_last_allocations = allocations;
+
+  if (draw_data != nullptr) {
+    m_vertices = draw_data->TotalVtxCount;
+    m_indices = draw_data->TotalIdxCount;
+  }
+}
+
+void PerformancePanel::draw(bool* open) {
+  APP_PROFILE_FUNCTION();
+
+  if (!ImGui::Begin("Performance", open)) {
+    ImGui::End();
+    return;
+  }
+
+  ImGui::TextUnformatted("Durations over the last frames or jobs");
+  for (const StageLabel& entry : stage_labels) {
+    draw_series(entry.label, FrameStats::get().stage(entry.stage), true);
+  }
+
+  ImGui::Separator();
+  draw_series("Evaluations per frame", m_evaluations, false);
+  draw_series("Allocations per frame", m_allocations, false);
+  ImGui::Text("Draw lists: %d vertices, %d indices", m_vertices, m_indices);
+
+  ImGui::End();
+}
+
+void PerformancePanel::draw_series(const char* label,
+    const RollingSeries& series,
+    bool in_milliseconds) {
+  const RollingSeries::Summary summary = series.summary(m_scratch);
+  const auto p50 = static_cast<double>(summary.p50);
+  const auto p95 = static_cast<double>(summary.p95);
+  const auto p99 = static_cast<double>(summary.p99);
+  if (in_milliseconds) {
+    ImGui::Text("%s: p50 %.2f ms  p95 %.2f ms  p99 %.2f ms", label, p50, p95, p99);
+  } else {
+    ImGui::Text("%s: p50 %.0f  p95 %.0f  p99 %.0f", label, p50, p95, p99);
+  }
+
+  series.snapshot(m_values);
+  ImGui::PushID(label);
+  ImGui::PlotHistogram("##history",
+      m_values.data(),
+      static_cast<int>(m_values.size()),
+      0,
+      nullptr,
+      0.0F,
+      summary.p99 > 0.0F ? summary.p99 : 1.0F,
+      ImVec2(-1.0F, histogram_height));
+  ImGui::PopID();
+}
+
+}  // namespace App::Debug
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/Debug/FrameStats.hpp"
+
+namespace App::Debug {
+
+// Live view of FrameStats: rolling frame time histograms with p50/p95/p99 per stage,
+// plus per-frame counts of point evaluations, allocations and draw list geometry.
+class PerformancePanel {
+ public:
+  // Samples the per-frame counters. Call once per rendered frame after ImGui::Render().
+  void end_frame(const ImDrawData* draw_data);
+  void draw(bool* open);
+
+ private:
+  void draw_series(const char* label, const RollingSeries& series, bool in_milliseconds);
+
+  RollingSeries m_evaluations;
+  RollingSeries m_allocations;
+  std::uint64_t m_last_evaluations{0};
+  std::uint64_t m_last_allocations{0};
+  int m_vertices{0};
+  int m_indices{0};
+
+  std::vector<float> m_values;
+  std::vector<float> m_scratch;
+};
+
+}  // namespace App::Debug
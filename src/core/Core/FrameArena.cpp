@@ -0,0 +1,54 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace App {
+
+FrameArena::FrameArena(std::size_t capacity) {
+  add_block(std::max<std::size_t>(capacity, 1));
+}
+
+FrameArena::~FrameArena() = default;
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+  Block* block = &m_blocks.back();
+  void* pointer = block->data.get() + m_offset;
+  std::size_t space = block->size - m_offset;
+  if (std::align(alignment, bytes, pointer, space) == nullptr) {
+    // Doubling keeps the number of blocks of one frame logarithmic in its size
+    add_block(std::max(block->size * 2, bytes + alignment));
+    block = &m_blocks.back();
+    pointer = block->data.get();
+    space = block->size;
+    std::align(alignment, bytes, pointer, space);
+  }
+
+  m_offset = static_cast<std::size_t>(static_cast<std::byte*>(pointer) - block->data.get()) + bytes;
+  return pointer;
+}
+
+void FrameArena::reset() {
+  if (m_blocks.size() > 1) {
+    const std::size_t combined = capacity();
+    m_blocks.clear();
+    add_block(combined);
+  }
+  m_offset = 0;
+}
+
+std::size_t FrameArena::capacity() const {
+  std::size_t bytes = 0;
+  for (const Block& block : m_blocks) {
+    bytes += block.size;
+  }
+  return bytes;
+}
+
+void FrameArena::add_block(std::size_t size) {
+  m_blocks.push_back({std::make_unique<std::byte[]>(size), size});
+  m_offset = 0;
+}
+
+}  // namespace App
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace App {
+
+// Bump allocator for scratch memory that only lives until the next reset(), e.g. the
+// screen-space points of one frame. Allocating advances an offset and nothing is freed on
+// its own. Memory is kept across resets, so once a frame's high-water mark was reached the
+// frames after it allocate nothing from the heap.
+class FrameArena {
+ public:
+  static constexpr std::size_t default_capacity = std::size_t{64} << 10U;
+
+  explicit FrameArena(std::size_t capacity = default_capacity);
+  ~FrameArena();
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) = delete;
+  FrameArena& operator=(FrameArena other) = delete;
+  FrameArena& operator=(FrameArena&& other) = delete;
+
+  // `alignment` must be a power of two. Takes a new block when the current one is full.
+  [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment);
+
+  // Releases everything allocated since the last reset. When that took more than one
+  // block they are replaced by a single block of their combined size.
+  void reset();
+
+  // Bytes of every block together.
+  [[nodiscard]] std::size_t capacity() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size{0};
+  };
+
+  void add_block(std::size_t size);
+
+  // Allocations are taken from the last block
+  std::vector<Block> m_blocks;
+  std::size_t m_offset{0};
+};
+
+// Standard allocator handing out memory of a FrameArena, for containers that are cleared
+// with it. Deallocation does nothing.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+  [[nodiscard]] T* allocate(std::size_t count) {
+    return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* /*pointer*/, std::size_t /*count*/) noexcept {}
+
+  [[nodiscard]] FrameArena* arena() const noexcept {
+    return m_arena;
+  }
+
+  template <typename U>
+  [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return m_arena == other.arena();
+  }
+
+ private:
+  FrameArena* m_arena;
+};
+
+// A vector that lives until its arena is reset; reserve up front so growing does not
+// leave the old buffers behind in the arena.
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace App
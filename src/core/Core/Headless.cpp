@@ -0,0 +1,283 @@
+#include "Headless.hpp"
+
+#include <SDL2/SDL.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/Log.hpp"
+#include "Core/PngWriter.hpp"
+#include "Core/Plot/Axes.hpp"
+#include "Core/Plot/ExpressionCache.hpp"
+#include "Core/Plot/PlotLayer.hpp"
+#include "Core/ThreadPool.hpp"
+
+namespace App {
+
+namespace {
+
+constexpr int max_size = 16384;
+// Units visible along the shorter side when no zoom is given
+constexpr float default_extent = 20.0F;
+constexpr float line_thickness = 6.0F;
+
+std::optional<int> parse_int(std::string_view text) {
+  int value = 0;
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<float> parse_float(const std::string& text) {
+  char* end = nullptr;
+  const float value = std::strtof(text.c_str(), &end);
+  if (text.empty() || end != text.c_str() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Splits "<a><separator><b>", e.g. "4096x4096" or "1.5,-2".
+std::optional<std::pair<std::string, std::string>> split(std::string_view text, char separator) {
+  const std::size_t at = text.find(separator);
+  if (at == std::string_view::npos) {
+    return std::nullopt;
+  }
+  return std::pair{std::string(text.substr(0, at)), std::string(text.substr(at + 1))};
+}
+
+}  // namespace
+
+bool HeadlessSettings::requested(std::span<char* const> arguments) {
+  return std::any_of(arguments.begin(), arguments.end(), [](const char* argument) {
+    return std::string_view(argument) == "--headless";
+  });
+}
+
+std::optional<HeadlessSettings> HeadlessSettings::parse(std::span<char* const> arguments) {
+  HeadlessSettings settings;
+  bool has_expression = false;
+
+  // arguments[0] is the program itself
+  for (std::size_t i = 1; i < arguments.size(); ++i) {
+    const std::string_view option(arguments[i]);
+    if (option == "--headless") {
+      continue;
+    }
+
+    if (i + 1 >= arguments.size()) {
+      APP_ERROR("Missing value for {}", option);
+      return std::nullopt;
+    }
+    const std::string value(arguments[++i]);
+
+    if (option == "--expr") {
+      settings.expression = value;
+      has_expression = true;
+    } else if (option == "--out") {
+      settings.output = value;
+    } else if (option == "--size") {
+      const auto parts = split(value, 'x');
+      const auto width = parts ? parse_int(parts->first) : std::nullopt;
+      const auto height = parts ? parse_int(parts->second) : std::nullopt;
+      if (!width || !height || *width < 1 || *height < 1 || *width > max_size ||
+          *height > max_size) {
+        APP_ERROR("Invalid --size '{}', expected <width>x<height> up to {}", value, max_size);
+        return std::nullopt;
+      }
+      settings.width = *width;
+      settings.height = *height;
+    } else if (option == "--zoom") {
+      const auto zoom = parse_float(value);
+      if (!zoom || !(*zoom > 0.0F)) {
+        APP_ERROR("Invalid --zoom '{}', expected a positive number of pixels per unit", value);
+        return std::nullopt;
+      }
+      settings.zoom = *zoom;
+    } else if (option == "--center") {
+      const auto parts = split(value, ',');
+      const auto x = parts ? parse_float(parts->first) : std::nullopt;
+      const auto y = parts ? parse_float(parts->second) : std::nullopt;
+      if (!x || !y) {
+        APP_ERROR("Invalid --center '{}', expected <x>,<y>", value);
+        return std::nullopt;
+      }
+      settings.center = ImVec2(*x, *y);
+    } else if (option == "--engine") {
+      if (value == "grid") {
+        settings.implicit_engine = Plot::ImplicitEngine::Grid;
+      } else if (value == "quadtree") {
+        settings.implicit_engine = Plot::ImplicitEngine::Quadtree;
+      } else {
+        APP_ERROR("Invalid --engine '{}', expected grid or quadtree", value);
+        return std::nullopt;
+      }
+    } else {
+      APP_ERROR("Unknown option {}", option);
+      return std::nullopt;
+    }
+  }
+
+  if (!has_expression) {
+    APP_ERROR("--headless needs an expression to plot, given with --expr");
+    return std::nullopt;
+  }
+
+  if (settings.zoom == 0.0F) {
+    settings.zoom = static_cast<float>(std::min(settings.width, settings.height)) / default_extent;
+  }
+  return settings;
+}
+
+HeadlessRenderer::HeadlessRenderer(HeadlessSettings settings) : m_settings(std::move(settings)) {
+  APP_PROFILE_FUNCTION();
+
+  m_surface = SDL_CreateRGBSurfaceWithFormat(
+      0, m_settings.width, m_settings.height, 32, SDL_PIXELFORMAT_ABGR8888);
+  if (m_surface == nullptr) {
+    APP_ERROR("Error creating offscreen surface: {}", SDL_GetError());
+    m_exit_status = ExitStatus::FAILURE;
+    return;
+  }
+
+  m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+  if (m_renderer == nullptr) {
+    APP_ERROR("Error creating software renderer: {}", SDL_GetError());
+    m_exit_status = ExitStatus::FAILURE;
+  }
+}
+
+HeadlessRenderer::~HeadlessRenderer() {
+  APP_PROFILE_FUNCTION();
+
+  if (m_renderer != nullptr) {
+    SDL_DestroyRenderer(m_renderer);
+  }
+  if (m_surface != nullptr) {
+    SDL_FreeSurface(m_surface);
+  }
+}
+
+ExitStatus HeadlessRenderer::run() {
+  APP_PROFILE_FUNCTION();
+
+  if (m_exit_status == ExitStatus::FAILURE) {
+    return m_exit_status;
+  }
+
+  const ImVec2 canvas_size(static_cast<float>(m_settings.width),
+      static_cast<float>(m_settings.height));
+  const Plot::PlotView view{
+      m_settings.zoom, canvas_size, m_settings.center, m_settings.implicit_engine};
+
+  Plot::PlotResult result;
+  {
+    APP_PROFILE_SCOPE("Sampling");
+
+    ThreadPool thread_pool;
+    Plot::ExpressionCache expressions;
+    Plot::PlotSampler sampler(thread_pool);
+
+    if (expressions.get(m_settings.expression).mode == Plot::PlotMode::None) {
+      APP_ERROR("Could not parse expression '{}'", m_settings.expression);
+      return ExitStatus::FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    sampler.sample(expressions, view, 1.0, {}, result);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    APP_INFO("Sampled '{}' in {:.2f} ms on {} threads",
+        m_settings.expression,
+        elapsed.count(),
+        thread_pool.size());
+  }
+
+  // Dear ImGui only needs a display size and a font atlas to build draw lists; the
+  // renderer backend turns them into geometry on the software renderer.
+  IMGUI_CHECKVERSION();
+  ImGui::CreateContext();
+  ImGuiIO& io{ImGui::GetIO()};
+  io.IniFilename = nullptr;
+  io.DisplaySize = canvas_size;
+  io.DeltaTime = 1.0F / 60.0F;
+  ImGui_ImplSDLRenderer2_Init(m_renderer);
+
+  std::vector<std::uint32_t> pixels(
+      static_cast<std::size_t>(m_settings.width) * static_cast<std::size_t>(m_settings.height));
+  {
+    APP_PROFILE_SCOPE("Rendering");
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ImGui_ImplSDLRenderer2_NewFrame();
+    ImGui::NewFrame();
+
+    ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
+    const ImVec2 origin(canvas_size.x * 0.5F - m_settings.center.x * m_settings.zoom,
+        canvas_size.y * 0.5F + m_settings.center.y * m_settings.zoom);
+    Plot::draw_axes(
+        draw_list, ImVec2(0.0F, 0.0F), canvas_size, origin, m_settings.zoom, line_thickness);
+
+    // The layer's region texture belongs to the renderer, so it goes before it
+    Plot::PlotLayer layer(m_renderer);
+    FrameArena scratch;
+    layer.update(std::move(result));
+    layer.draw(draw_list, origin, m_settings.zoom, line_thickness, scratch);
+
+    ImGui::Render();
+
+    SDL_SetRenderDrawColor(m_renderer, 255, 255, 255, 255);
+    SDL_RenderClear(m_renderer);
+    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), m_renderer);
+
+    if (SDL_RenderReadPixels(m_renderer,
+            nullptr,
+            SDL_PIXELFORMAT_ABGR8888,
+            pixels.data(),
+            m_settings.width * static_cast<int>(sizeof(std::uint32_t))) != 0) {
+      APP_ERROR("Error reading back the rendered plot: {}", SDL_GetError());
+      m_exit_status = ExitStatus::FAILURE;
+    }
+
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    APP_INFO("Rendered {}x{} in {:.2f} ms", m_settings.width, m_settings.height, elapsed.count());
+  }
+
+  ImGui_ImplSDLRenderer2_Shutdown();
+  ImGui::DestroyContext();
+
+  if (m_exit_status == ExitStatus::FAILURE) {
+    return m_exit_status;
+  }
+
+  if (!PngWriter::write(m_settings.output,
+          static_cast<std::uint32_t>(m_settings.width),
+          static_cast<std::uint32_t>(m_settings.height),
+          static_cast<std::size_t>(m_settings.width),
+          pixels)) {
+    APP_ERROR("Could not write {}", m_settings.output.string());
+    return ExitStatus::FAILURE;
+  }
+
+  APP_INFO("Wrote {}", m_settings.output.string());
+  return m_exit_status;
+}
+
+}  // namespace App
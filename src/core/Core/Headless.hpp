@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <imgui.h>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "Core/Application.hpp"
+#include "Core/Plot/PlotSampler.hpp"
+
+namespace App {
+
+// What to plot without a window: `App --headless --expr <text> [--out <file.png>]
+// [--size <width>x<height>] [--zoom <pixels per unit>] [--center <x>,<y>]
+// [--engine grid|quadtree]`.
+struct HeadlessSettings {
+  std::string expression;
+  std::filesystem::path output{"plot.png"};
+  int width{1024};
+  int height{1024};
+  // Pixels per unit; 0 fits [-10, 10] along the shorter side
+  float zoom{0.0F};
+  ImVec2 center{};
+  Plot::ImplicitEngine implicit_engine{Plot::ImplicitEngine::Grid};
+
+  [[nodiscard]] static bool requested(std::span<char* const> arguments);
+  // Logs the offending argument and returns nothing when the command line is invalid.
+  [[nodiscard]] static std::optional<HeadlessSettings> parse(std::span<char* const> arguments);
+};
+
+// Samples one plot with the same engines as the interactive view and renders it, with the
+// grid and axes, through Dear ImGui into a software renderer backed by an in-memory
+// surface, then writes the pixels to a PNG. Needs no display or GPU.
+class HeadlessRenderer {
+ public:
+  explicit HeadlessRenderer(HeadlessSettings settings);
+  ~HeadlessRenderer();
+
+  HeadlessRenderer(const HeadlessRenderer&) = delete;
+  HeadlessRenderer(HeadlessRenderer&&) = delete;
+  HeadlessRenderer& operator=(HeadlessRenderer other) = delete;
+  HeadlessRenderer& operator=(HeadlessRenderer&& other) = delete;
+
+  ExitStatus run();
+
+ private:
+  HeadlessSettings m_settings;
+  ExitStatus m_exit_status{ExitStatus::SUCCESS};
+  SDL_Surface* m_surface{nullptr};
+  SDL_Renderer* m_renderer{nullptr};
+};
+
+}  // namespace App
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace App {
+
+// A read-only view of a whole file through virtual memory: pages are only read from disk
+// when they are touched and the OS can drop them again under memory pressure, so files
+// much larger than the RAM can be used. Implemented per platform.
+class MappedFile {
+ public:
+  // Logs the reason and stays invalid when the file cannot be mapped.
+  explicit MappedFile(const std::filesystem::path& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile other) = delete;
+  MappedFile& operator=(MappedFile&& other) = delete;
+
+  [[nodiscard]] bool valid() const {
+    return m_valid;
+  }
+  // Empty for an empty file.
+  [[nodiscard]] std::span<const std::byte> bytes() const {
+    return {static_cast<const std::byte*>(m_data), m_size};
+  }
+
+ private:
+  const void* m_data{nullptr};
+  std::size_t m_size{0};
+  bool m_valid{false};
+};
+
+}  // namespace App
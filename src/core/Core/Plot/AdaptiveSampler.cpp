@@ -0,0 +1,216 @@
+#include "AdaptiveSampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Bisection steps spent on deciding whether a large jump is a discontinuity, as long as
+// the evaluation budget lasts.
+constexpr int MAX_JUMP_BISECTIONS{48};
+
+class Sampler {
+ public:
+  Sampler(const std::function<double(double)>& f,
+      const BatchFunction* f_batch,
+      const SamplerSettings& settings,
+      Polylines& out)
+      : m_f(f),
+        m_f_batch(f_batch),
+        m_settings(settings),
+        m_out(out) {
+    const double width_px = (settings.x_max - settings.x_min) * settings.pixels_per_unit;
+    m_min_dx = 1.0 / (settings.pixels_per_unit * settings.max_samples_per_pixel);
+    m_budget = static_cast<std::size_t>(std::max(1.0, width_px * settings.max_samples_per_pixel));
+  }
+
+  void run() {
+    const SamplerSettings& s = m_settings;
+    const double width_px = (s.x_max - s.x_min) * s.pixels_per_unit;
+    const auto intervals =
+        static_cast<std::size_t>(std::max(1.0, std::ceil(width_px / s.initial_spacing_px)));
+    const double dx = (s.x_max - s.x_min) / static_cast<double>(intervals);
+    const auto grid_x = [&s, dx](std::size_t i) {
+      return s.x_min + static_cast<double>(i) * dx;
+    };
+
+    // A batch function takes the whole initial grid at once, only the points refinement
+    // adds are evaluated one at a time
+    std::vector<double> grid_values;
+    if (m_f_batch != nullptr) {
+      std::vector<double> xs(intervals + 1);
+      for (std::size_t i = 0; i <= intervals; ++i) {
+        xs[i] = grid_x(i);
+      }
+      grid_values.resize(xs.size());
+      (*m_f_batch)(xs, grid_values);
+      m_evaluations += xs.size();
+    }
+    const auto grid_value = [&](std::size_t i) {
+      return grid_values.empty() ? eval(grid_x(i)) : grid_values[i];
+    };
+
+    double x0 = s.x_min;
+    double y0 = grid_value(0);
+    if (std::isfinite(y0)) {
+      emit(x0, y0);
+    }
+
+    for (std::size_t i = 1; i <= intervals; ++i) {
+      const double x1 = grid_x(i);
+      const double y1 = grid_value(i);
+      if (grid_values.empty()) {
+        m_reserved = intervals - i;
+      }
+      refine(x0, y0, x1, y1);
+      x0 = x1;
+      y0 = y1;
+    }
+
+    m_out.end_strip();
+  }
+
+  [[nodiscard]] std::size_t evaluations() const {
+    return m_evaluations;
+  }
+
+ private:
+  double eval(double x) {
+    ++m_evaluations;
+    return m_f(x);
+  }
+
+  // Whether an evaluation beyond the initial grid fits in the budget. The grid points
+  // still ahead are held back for it, so splitting intervals and checking jumps share
+  // what is left.
+  [[nodiscard]] bool has_budget() const {
+    return m_evaluations + m_reserved < m_budget;
+  }
+
+  void emit(double x, double y) {
+    const double limit = m_settings.y_limit;
+    m_out.add_point(
+        ImVec2(static_cast<float>(x), static_cast<float>(std::clamp(y, -limit, limit))));
+  }
+
+  // Emits the samples after x0 up to and including x1; (x0, y0) has already been handled.
+  void refine(double x0, double y0, double x1, double y1) {
+    const bool finite0 = std::isfinite(y0);
+    const bool finite1 = std::isfinite(y1);
+
+    if (x1 - x0 > m_min_dx && has_budget()) {
+      const double xm = 0.5 * (x0 + x1);
+      const double ym = eval(xm);
+
+      const double chord_error_px =
+          std::abs(ym - 0.5 * (y0 + y1)) * m_settings.pixels_per_unit;
+      // NaN compares false, so a non-finite value anywhere also forces a split
+      if (!finite0 || !finite1 || !std::isfinite(ym) ||
+          !(chord_error_px <= m_settings.tolerance_px)) {
+        refine(x0, y0, xm, ym);
+        refine(xm, ym, x1, y1);
+        return;
+      }
+    }
+
+    if (!finite1) {
+      m_out.end_strip();
+      return;
+    }
+    if (finite0 && std::abs(y1 - y0) * m_settings.pixels_per_unit > m_settings.jump_px &&
+        is_discontinuous(x0, y0, x1, y1)) {
+      m_out.end_strip();
+    }
+    emit(x1, y1);
+  }
+
+  // A continuous function's jump halves (roughly) with every bisection of the interval,
+  // while the jump across a pole or a step stays large however narrow the interval gets.
+  // A jump still undecided when the budget runs out is kept, as a plain sampler would.
+  bool is_discontinuous(double x0, double y0, double x1, double y1) {
+    for (int i = 0; i < MAX_JUMP_BISECTIONS; ++i) {
+      if (!has_budget()) {
+        return false;
+      }
+
+      const double xm = 0.5 * (x0 + x1);
+      if (xm <= x0 || xm >= x1) {
+        break;
+      }
+
+      const double ym = eval(xm);
+      if (!std::isfinite(ym)) {
+        return true;
+      }
+
+      // Follow the half holding the larger part of the jump
+      if (std::abs(ym - y0) > std::abs(y1 - ym)) {
+        x1 = xm;
+        y1 = ym;
+      } else {
+        x0 = xm;
+        y0 = ym;
+      }
+
+      if (std::abs(y1 - y0) * m_settings.pixels_per_unit <= m_settings.jump_px) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::function<double(double)>& m_f;
+  const BatchFunction* m_f_batch;
+  const SamplerSettings& m_settings;
+  Polylines& m_out;
+
+  double m_min_dx{0.0};
+  std::size_t m_budget{0};
+  // Initial grid points not evaluated yet
+  std::size_t m_reserved{0};
+  std::size_t m_evaluations{0};
+};
+
+std::size_t sample(const std::function<double(double)>& f,
+    const BatchFunction* f_batch,
+    const SamplerSettings& settings,
+    Polylines& out) {
+  out.clear();
+  if (!(settings.x_max > settings.x_min) || !(settings.pixels_per_unit > 0.0)) {
+    return 0;
+  }
+
+  Sampler sampler{f, f_batch, settings, out};
+  sampler.run();
+  return sampler.evaluations();
+}
+
+}  // namespace
+
+std::size_t sample_explicit(const std::function<double(double)>& f,
+    const SamplerSettings& settings,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  return sample(f, nullptr, settings, out);
+}
+
+std::size_t sample_explicit(const std::function<double(double)>& f,
+    const BatchFunction& f_batch,
+    const SamplerSettings& settings,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  return sample(f, &f_batch, settings, out);
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <span>
+
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+struct SamplerSettings {
+  double x_min{-1.0};
+  double x_max{1.0};
+  // Screen pixels per world unit, i.e. the current zoom.
+  double pixels_per_unit{100.0};
+  // |y| beyond this is clamped so far off-screen samples stay representable as floats.
+  double y_limit{1.0e6};
+
+  double initial_spacing_px{2.0};
+  // Maximum distance between the curve and its chord before an interval is split.
+  double tolerance_px{0.25};
+  // Hard cap on the evaluations spent per horizontal pixel.
+  double max_samples_per_pixel{4.0};
+  // Jumps larger than this are checked for being a discontinuity.
+  double jump_px{32.0};
+};
+
+// Samples y = f(x) into world-space polylines. Intervals are split recursively while the
+// curve deviates from the straight segment by more than the pixel tolerance. Strips are
+// broken at non-finite values and at jumps which do not shrink under bisection (poles
+// of tan or 1/x), so no vertical spikes are drawn across them.
+//
+// Returns the number of times `f` was evaluated.
+std::size_t sample_explicit(const std::function<double(double)>& f,
+    const SamplerSettings& settings,
+    Polylines& out);
+
+// Evaluates f at every x of `xs` into `ys`, e.g. through a BatchProgram.
+using BatchFunction = std::function<void(std::span<const double> xs, std::span<double> ys)>;
+
+// As above, with the initial grid of samples evaluated by one call to `f_batch`. Only
+// the points refinement adds go through `f`.
+std::size_t sample_explicit(const std::function<double(double)>& f,
+    const BatchFunction& f_batch,
+    const SamplerSettings& settings,
+    Polylines& out);
+
+}  // namespace App::Plot
@@ -0,0 +1,63 @@
+#include "Axes.hpp"
+
+#include <imgui.h>
+
+#include <cmath>
+
+#include "Core/Debug/Instrumentor.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+constexpr ImU32 grid_color = IM_COL32(200, 200, 200, 255);
+constexpr ImU32 axis_color = IM_COL32(0, 0, 0, 255);
+constexpr float grid_thickness = 1.0F;
+constexpr float min_pixel_spacing = 20.0F;
+
+}  // namespace
+
+void draw_axes(ImDrawList* draw_list,
+    const ImVec2& canvas_min,
+    const ImVec2& canvas_max,
+    const ImVec2& origin,
+    float zoom,
+    float axis_thickness) {
+  APP_PROFILE_FUNCTION();
+
+  float step = 1.0F;
+  while (step * zoom < min_pixel_spacing) {
+    step *= 2.0F;
+  }
+
+  // Vertical gridlines over the visible (possibly panned) range
+  for (float x = std::floor((canvas_min.x - origin.x) / (step * zoom)) * step;
+       origin.x + x * zoom < canvas_max.x;
+       x += step) {
+    if (x != 0) {
+      draw_list->AddLine(ImVec2(origin.x + x * zoom, canvas_min.y),
+          ImVec2(origin.x + x * zoom, canvas_max.y),
+          grid_color,
+          grid_thickness);
+    }
+  }
+
+  // Horizontal gridlines
+  for (float y = std::floor((canvas_min.y - origin.y) / (step * zoom)) * step;
+       origin.y + y * zoom < canvas_max.y;
+       y += step) {
+    if (y != 0) {
+      draw_list->AddLine(ImVec2(canvas_min.x, origin.y + y * zoom),
+          ImVec2(canvas_max.x, origin.y + y * zoom),
+          grid_color,
+          grid_thickness);
+    }
+  }
+
+  draw_list->AddLine(
+      ImVec2(canvas_min.x, origin.y), ImVec2(canvas_max.x, origin.y), axis_color, axis_thickness);
+  draw_list->AddLine(
+      ImVec2(origin.x, canvas_min.y), ImVec2(origin.x, canvas_max.y), axis_color, axis_thickness);
+}
+
+}  // namespace App::Plot
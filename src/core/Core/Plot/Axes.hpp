@@ -0,0 +1,16 @@
+#pragma once
+
+#include <imgui.h>
+
+namespace App::Plot {
+
+// Draws the gridlines over the canvas, starting at integer spacing and doubling it until
+// lines are a readable distance apart, then the two axes through `origin`.
+void draw_axes(ImDrawList* draw_list,
+    const ImVec2& canvas_min,
+    const ImVec2& canvas_max,
+    const ImVec2& origin,
+    float zoom,
+    float axis_thickness);
+
+}  // namespace App::Plot
@@ -0,0 +1,244 @@
+#include "BatchProgram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Plot/ExpressionTree.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+template <typename F>
+void unary(std::size_t count, const double* a, double* out, F f) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = f(a[i]);
+  }
+}
+
+template <typename F>
+void binary(std::size_t count, const double* a, const double* b, double* out, F f) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = f(a[i], b[i]);
+  }
+}
+
+// The operations common in plots get loops of their own; everything else goes through
+// ExpressionTree::apply lane by lane so the semantics cannot drift apart.
+void run(Op op, std::size_t count, const double* a, const double* b, double* out) {
+  switch (op) {
+    case Op::Negate:
+      unary(count, a, out, [](double v) { return -v; });
+      break;
+    case Op::Add:
+      binary(count, a, b, out, [](double u, double v) { return u + v; });
+      break;
+    case Op::Subtract:
+      binary(count, a, b, out, [](double u, double v) { return u - v; });
+      break;
+    case Op::Multiply:
+      binary(count, a, b, out, [](double u, double v) { return u * v; });
+      break;
+    case Op::Divide:
+      binary(count, a, b, out, [](double u, double v) { return u / v; });
+      break;
+    case Op::Power:
+      binary(count, a, b, out, [](double u, double v) { return std::pow(u, v); });
+      break;
+    case Op::Less:
+      binary(count, a, b, out, [](double u, double v) { return u < v ? 1.0 : 0.0; });
+      break;
+    case Op::LessEqual:
+      binary(count, a, b, out, [](double u, double v) { return u <= v ? 1.0 : 0.0; });
+      break;
+    case Op::Greater:
+      binary(count, a, b, out, [](double u, double v) { return u > v ? 1.0 : 0.0; });
+      break;
+    case Op::GreaterEqual:
+      binary(count, a, b, out, [](double u, double v) { return u >= v ? 1.0 : 0.0; });
+      break;
+    case Op::Min:
+      binary(count, a, b, out, [](double u, double v) { return std::min(u, v); });
+      break;
+    case Op::Max:
+      binary(count, a, b, out, [](double u, double v) { return std::max(u, v); });
+      break;
+    case Op::Abs:
+      unary(count, a, out, [](double v) { return std::abs(v); });
+      break;
+    case Op::Sqrt:
+      unary(count, a, out, [](double v) { return std::sqrt(v); });
+      break;
+    case Op::Floor:
+      unary(count, a, out, [](double v) { return std::floor(v); });
+      break;
+    case Op::Ceil:
+      unary(count, a, out, [](double v) { return std::ceil(v); });
+      break;
+    case Op::Sin:
+      unary(count, a, out, [](double v) { return std::sin(v); });
+      break;
+    case Op::Cos:
+      unary(count, a, out, [](double v) { return std::cos(v); });
+      break;
+    case Op::Tan:
+      unary(count, a, out, [](double v) { return std::tan(v); });
+      break;
+    case Op::Exp:
+      unary(count, a, out, [](double v) { return std::exp(v); });
+      break;
+    case Op::Log:
+      unary(count, a, out, [](double v) { return std::log(v); });
+      break;
+    default:
+      binary(count, a, b, out, [op](double u, double v) {
+        return ExpressionTree::apply(op, u, v);
+      });
+      break;
+  }
+}
+
+bool is_unary(Op op) {
+  return op == Op::Negate || (op >= Op::Abs && op <= Op::Trunc);
+}
+
+}  // namespace
+
+BatchProgram BatchProgram::compile(const ExpressionTree& tree) {
+  const std::vector<Node>& nodes = tree.nodes();
+
+  BatchProgram program;
+  program.m_variable_count = tree.variable_count();
+
+  // Last node reading each node, so its register can be handed out again afterwards
+  std::vector<std::size_t> last_use(nodes.size(), 0);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    const Node& node = nodes[i];
+    if (node.op != Op::Constant && node.op != Op::Variable) {
+      last_use[node.lhs] = i;
+      if (!is_unary(node.op)) {
+        last_use[node.rhs] = i;
+      }
+    }
+  }
+
+  std::vector<double> constants;
+  for (const Node& node : nodes) {
+    if (node.op == Op::Constant) {
+      constants.push_back(node.value);
+    }
+  }
+  program.m_constant_count = constants.size();
+
+  const auto register_source = [&program](std::uint32_t index) {
+    return static_cast<std::uint32_t>(program.m_variable_count + program.m_constant_count + index);
+  };
+
+  std::vector<std::uint32_t> source(nodes.size(), 0);
+  std::vector<std::uint32_t> free_registers;
+  std::uint32_t next_constant = 0;
+
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    const Node& node = nodes[i];
+
+    if (node.op == Op::Constant) {
+      source[i] = static_cast<std::uint32_t>(program.m_variable_count) + next_constant++;
+      continue;
+    }
+    if (node.op == Op::Variable) {
+      source[i] = node.lhs;
+      continue;
+    }
+
+    Instruction instruction;
+    instruction.op = node.op;
+    instruction.lhs = source[node.lhs];
+    instruction.rhs = is_unary(node.op) ? instruction.lhs : source[node.rhs];
+
+    // x^2 is by far the most common power
+    if (node.op == Op::Power && nodes[node.rhs].op == Op::Constant &&
+        nodes[node.rhs].value == 2.0) {
+      instruction.op = Op::Multiply;
+      instruction.rhs = instruction.lhs;
+    }
+
+    // Operands consumed here free their registers before the result is placed, so
+    // elementwise instructions may run in place
+    for (const std::uint32_t operand : {node.lhs, node.rhs}) {
+      const bool is_register =
+          nodes[operand].op != Op::Constant && nodes[operand].op != Op::Variable;
+      const bool is_operand = operand == node.lhs || !is_unary(node.op);
+      if (!is_register || !is_operand || last_use[operand] != i) {
+        continue;
+      }
+
+      const std::uint32_t freed = source[operand] - register_source(0);
+      if (std::find(free_registers.begin(), free_registers.end(), freed) == free_registers.end()) {
+        free_registers.push_back(freed);
+      }
+    }
+
+    std::uint32_t destination = 0;
+    if (free_registers.empty()) {
+      destination = static_cast<std::uint32_t>(program.m_register_count++);
+    } else {
+      destination = free_registers.back();
+      free_registers.pop_back();
+    }
+
+    instruction.destination = destination;
+    source[i] = register_source(destination);
+    program.m_instructions.push_back(instruction);
+  }
+
+  program.m_result = nodes.empty() ? 0 : source.back();
+
+  program.m_constant_lanes.resize(constants.size() * block_size);
+  for (std::size_t c = 0; c < constants.size(); ++c) {
+    std::fill_n(program.m_constant_lanes.begin() + static_cast<std::ptrdiff_t>(c * block_size),
+        block_size,
+        constants[c]);
+  }
+
+  return program;
+}
+
+void BatchProgram::evaluate(std::span<const double* const> inputs,
+    std::span<double> out,
+    BatchWorkspace& workspace) const {
+  workspace.registers.resize(m_register_count * block_size);
+  workspace.sources.resize(m_variable_count + m_constant_count + m_register_count);
+
+  for (std::size_t c = 0; c < m_constant_count; ++c) {
+    workspace.sources[m_variable_count + c] = m_constant_lanes.data() + c * block_size;
+  }
+  for (std::size_t r = 0; r < m_register_count; ++r) {
+    workspace.sources[m_variable_count + m_constant_count + r] =
+        workspace.registers.data() + r * block_size;
+  }
+
+  for (std::size_t offset = 0; offset < out.size(); offset += block_size) {
+    const std::size_t count = std::min(block_size, out.size() - offset);
+    for (std::size_t v = 0; v < m_variable_count; ++v) {
+      workspace.sources[v] = inputs[v] + offset;
+    }
+
+    for (const Instruction& instruction : m_instructions) {
+      double* destination = workspace.registers.data() + instruction.destination * block_size;
+      run(instruction.op,
+          count,
+          workspace.sources[instruction.lhs],
+          workspace.sources[instruction.rhs],
+          destination);
+    }
+
+    std::copy_n(
+        workspace.sources[m_result], count, out.begin() + static_cast<std::ptrdiff_t>(offset));
+  }
+}
+
+}  // namespace App::Plot
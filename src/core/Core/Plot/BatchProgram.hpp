@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Plot/ExpressionTree.hpp"
+
+namespace App::Plot {
+
+// Per-thread registers of a BatchProgram evaluation.
+struct BatchWorkspace {
+  std::vector<double> registers;
+  std::vector<const double*> sources;
+  // Input table callers can assemble without allocating on every evaluation
+  std::vector<const double*> inputs;
+};
+
+// An ExpressionTree lowered to straight-line code over blocks of inputs. Every
+// instruction runs one tight loop over up to `block_size` lanes, so the per-sample cost
+// of walking the tree is paid once per block and the arithmetic loops are left for the
+// compiler to vectorize. Registers are reused as soon as their value is consumed, which
+// keeps the working set of a block in the L1 cache.
+class BatchProgram {
+ public:
+  static constexpr std::size_t block_size = 256;
+
+  [[nodiscard]] static BatchProgram compile(const ExpressionTree& tree);
+
+  // out[i] = f(inputs[0][i], inputs[1][i], ...) for every i < out.size(). `inputs` holds
+  // one array per variable of the tree, each at least out.size() long.
+  void evaluate(std::span<const double* const> inputs,
+      std::span<double> out,
+      BatchWorkspace& workspace) const;
+
+  [[nodiscard]] std::size_t instruction_count() const {
+    return m_instructions.size();
+  }
+  [[nodiscard]] std::size_t register_count() const {
+    return m_register_count;
+  }
+
+ private:
+  // Operands index the source table: variables, then constants, then registers
+  struct Instruction {
+    Op op{Op::Add};
+    std::uint32_t destination{0};  // register index
+    std::uint32_t lhs{0};
+    std::uint32_t rhs{0};
+  };
+
+  std::vector<Instruction> m_instructions;
+  // Every constant repeated over a whole block
+  std::vector<double> m_constant_lanes;
+  std::size_t m_variable_count{0};
+  std::size_t m_constant_count{0};
+  std::size_t m_register_count{0};
+  std::uint32_t m_result{0};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace App::Plot {
+
+// Lets a long evaluation notice that its result is no longer wanted: the job is cancelled
+// as soon as the generation counter it was started under moves on. A default constructed
+// token is never cancelled.
+class CancelToken {
+ public:
+  CancelToken() = default;
+  CancelToken(const std::atomic<std::uint64_t>& generation, std::uint64_t job)
+      : m_generation(&generation), m_job(job) {}
+
+  [[nodiscard]] bool cancelled() const {
+    return m_generation != nullptr && m_generation->load(std::memory_order_relaxed) != m_job;
+  }
+
+ private:
+  const std::atomic<std::uint64_t>* m_generation{nullptr};
+  std::uint64_t m_job{0};
+};
+
+}  // namespace App::Plot
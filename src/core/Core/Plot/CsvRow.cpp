@@ -0,0 +1,60 @@
+#include "CsvRow.hpp"
+
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace App::Plot {
+
+namespace {
+
+std::optional<double> parse_field(std::string_view field) {
+  field = trim_blanks(field);
+  if (field.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (field.front() == '+') {
+    field.remove_prefix(1);
+  }
+
+  double value = 0.0;
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc{} || end != field.data() + field.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+}  // namespace
+
+std::string_view trim_blanks(std::string_view text) {
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+std::optional<CsvRow> parse_csv_row(std::string_view line) {
+  const std::size_t comma = line.find(',');
+  const auto first = parse_field(line.substr(0, comma));
+  if (!first) {
+    return std::nullopt;
+  }
+  if (comma == std::string_view::npos) {
+    return CsvRow{1, *first, 0.0};
+  }
+
+  const std::string_view rest = line.substr(comma + 1);
+  const auto second = parse_field(rest.substr(0, rest.find(',')));
+  if (!second) {
+    return std::nullopt;
+  }
+  return CsvRow{2, *first, *second};
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace App::Plot {
+
+// One sample in text form, "y" or "x,y", as in CSV data files and text streams. Columns
+// after the second are ignored and empty fields are missing values (NaN).
+struct CsvRow {
+  std::size_t columns{1};
+  double first{0.0};
+  double second{0.0};
+};
+
+// Removes leading and trailing spaces, tabs and carriage returns.
+[[nodiscard]] std::string_view trim_blanks(std::string_view text);
+
+// Returns nothing when a field is not a number, e.g. in a header row.
+[[nodiscard]] std::optional<CsvRow> parse_csv_row(std::string_view line);
+
+}  // namespace App::Plot
@@ -0,0 +1,70 @@
+#include "DataLayer.hpp"
+
+#include <imgui.h>
+
+#include <memory>
+#include <utility>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/FrameArena.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+constexpr ImU32 data_color = IM_COL32(60, 60, 60, 255);
+
+}  // namespace
+
+void DataLayer::set_series(std::unique_ptr<DataSeries> series) {
+  m_series = std::move(series);
+  m_level = 0;
+  ++m_revision;
+}
+
+void DataLayer::set_x_mapping(double x_offset, double x_scale) {
+  if (x_offset == m_x_offset && x_scale == m_x_scale) {
+    return;
+  }
+  m_x_offset = x_offset;
+  m_x_scale = x_scale;
+  ++m_revision;
+}
+
+void DataLayer::draw(ImDrawList* draw_list,
+    const ImVec2& canvas_min,
+    const ImVec2& canvas_max,
+    const ImVec2& origin,
+    float zoom,
+    float thickness,
+    FrameArena& scratch) {
+  APP_PROFILE_FUNCTION();
+
+  if (m_series == nullptr || canvas_max.x <= canvas_min.x) {
+    return;
+  }
+
+  DataWindow window;
+  window.x_min = static_cast<double>((canvas_min.x - origin.x) / zoom);
+  window.x_max = static_cast<double>((canvas_max.x - origin.x) / zoom);
+  window.pixels = static_cast<double>(canvas_max.x - canvas_min.x);
+  window.x_offset = m_x_offset;
+  window.x_scale = m_x_scale;
+
+  m_visible.clear();
+  m_level = m_series->visible(window, m_visible);
+
+  // Up to fan_out buckets per pixel come back, the column reduction brings that down to
+  // what can be seen
+  draw_world_polylines(draw_list,
+      m_visible,
+      origin,
+      zoom,
+      data_color,
+      thickness,
+      /*x_monotonic=*/true,
+      m_decimator,
+      scratch);
+}
+
+}  // namespace App::Plot
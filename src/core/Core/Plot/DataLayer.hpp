@@ -0,0 +1,59 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Core/Plot/DataSeries.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Decimation.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+// Draws a measured DataSeries over the expression plots. Only the part of the series
+// within the canvas is read, from the pyramid level matching the zoom, so the cost of a
+// frame follows the canvas width rather than the number of samples.
+class DataLayer {
+ public:
+  // Replaces the shown series; nullptr hides the layer.
+  void set_series(std::unique_ptr<DataSeries> series);
+  [[nodiscard]] const DataSeries* series() const {
+    return m_series.get();
+  }
+
+  // World x of a sample is x_offset + x_scale * its file x, see DataWindow.
+  void set_x_mapping(double x_offset, double x_scale);
+
+  void draw(ImDrawList* draw_list,
+      const ImVec2& canvas_min,
+      const ImVec2& canvas_max,
+      const ImVec2& origin,
+      float zoom,
+      float thickness,
+      FrameArena& scratch);
+
+  // The pyramid level of the last draw, 0 for raw samples.
+  [[nodiscard]] std::size_t level() const {
+    return m_level;
+  }
+  // Changes whenever the series or its mapping does.
+  [[nodiscard]] std::uint64_t revision() const {
+    return m_revision;
+  }
+
+ private:
+  std::unique_ptr<DataSeries> m_series;
+  double m_x_offset{0.0};
+  double m_x_scale{1.0};
+  std::size_t m_level{0};
+  std::uint64_t m_revision{0};
+
+  Polylines m_visible;
+  PolylineDecimator m_decimator;
+};
+
+}  // namespace App::Plot
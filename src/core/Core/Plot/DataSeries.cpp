@@ -0,0 +1,531 @@
+#include "DataSeries.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+#include "Core/Plot/CsvRow.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Bumped whenever the layout of the persisted pyramid changes
+constexpr std::array<char, 8> pyramid_magic{'P', 'L', 'O', 'T', 'L', 'O', 'D', '1'};
+
+// Followed by the x (when has_x) and y columns of CSV files as doubles, then by every
+// pyramid level from the finest. Everything stays 8-byte aligned.
+struct PyramidHeader {
+  std::array<char, 8> magic{};
+  std::uint64_t source_size{0};
+  std::int64_t source_time{0};
+  std::uint64_t sample_count{0};
+  std::uint32_t format{0};
+  std::uint32_t has_x{0};
+  std::uint64_t level_count{0};
+};
+
+struct SourceStamp {
+  std::uint64_t size{0};
+  std::int64_t time{0};
+};
+
+std::optional<SourceStamp> stamp(const std::filesystem::path& path) {
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  const auto time = std::filesystem::last_write_time(path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  return SourceStamp{size, static_cast<std::int64_t>(time.time_since_epoch().count())};
+}
+
+std::vector<std::size_t> level_sizes(std::size_t sample_count) {
+  std::vector<std::size_t> sizes;
+  std::size_t below = sample_count;
+  while (below > 1) {
+    below = (below + DataSeries::fan_out - 1) / DataSeries::fan_out;
+    sizes.push_back(below);
+  }
+  return sizes;
+}
+
+// Fills `y`, and `x` when the rows have two or more columns.
+bool parse_csv(std::string_view text,
+    const std::filesystem::path& path,
+    std::vector<double>& x,
+    std::vector<double>& y) {
+  APP_PROFILE_FUNCTION();
+
+  std::size_t line_number = 0;
+  std::size_t columns = 0;
+  while (!text.empty()) {
+    const std::size_t line_end = std::min(text.find('\n'), text.size());
+    const std::string_view line = trim_blanks(text.substr(0, line_end));
+    text.remove_prefix(std::min(line_end + 1, text.size()));
+    ++line_number;
+
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+
+    const auto row = parse_csv_row(line);
+    if (!row) {
+      if (columns == 0) {
+        // A header
+        columns = line.find(',') == std::string_view::npos ? 1 : 2;
+        continue;
+      }
+      APP_ERROR("{}:{}: expected numbers", path.string(), line_number);
+      return false;
+    }
+    if (columns == 0) {
+      columns = row->columns;
+    } else if (columns != row->columns) {
+      APP_ERROR("{}:{}: expected {} columns", path.string(), line_number, columns);
+      return false;
+    }
+
+    if (columns == 1) {
+      y.push_back(row->first);
+      continue;
+    }
+
+    // Finding the visible samples relies on x being sorted
+    if (!x.empty() && !(row->first >= x.back())) {
+      APP_ERROR("{}:{}: x must not decrease from one row to the next", path.string(), line_number);
+      return false;
+    }
+    x.push_back(row->first);
+    y.push_back(row->second);
+  }
+
+  return true;
+}
+
+DataBucket make_bucket(double y_min, double y_max) {
+  constexpr double limit = std::numeric_limits<float>::max();
+  if (y_min > y_max) {
+    return {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+  }
+  return {static_cast<float>(std::clamp(y_min, -limit, limit)),
+      static_cast<float>(std::clamp(y_max, -limit, limit))};
+}
+
+template <typename T>
+void reduce_samples(std::span<const T> y, std::span<DataBucket> out) {
+  for (std::size_t bucket = 0; bucket < out.size(); ++bucket) {
+    const std::size_t first = bucket * DataSeries::fan_out;
+    const std::size_t last = std::min(first + DataSeries::fan_out, y.size());
+
+    double y_min = std::numeric_limits<double>::infinity();
+    double y_max = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = first; i < last; ++i) {
+      const auto value = static_cast<double>(y[i]);
+      if (std::isfinite(value)) {
+        y_min = std::min(y_min, value);
+        y_max = std::max(y_max, value);
+      }
+    }
+    out[bucket] = make_bucket(y_min, y_max);
+  }
+}
+
+void reduce_buckets(std::span<const DataBucket> below, std::span<DataBucket> out) {
+  for (std::size_t bucket = 0; bucket < out.size(); ++bucket) {
+    const std::size_t first = bucket * DataSeries::fan_out;
+    const std::size_t last = std::min(first + DataSeries::fan_out, below.size());
+
+    // Empty buckets are (inf, -inf) and drop out of the min and max on their own
+    DataBucket reduced{std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity()};
+    for (std::size_t i = first; i < last; ++i) {
+      reduced.y_min = std::min(reduced.y_min, below[i].y_min);
+      reduced.y_max = std::max(reduced.y_max, below[i].y_max);
+    }
+    out[bucket] = reduced;
+  }
+}
+
+template <typename T>
+void write_array(std::ofstream& file, std::span<const T> values) {
+  file.write(reinterpret_cast<const char*>(values.data()),
+      static_cast<std::streamsize>(values.size_bytes()));
+}
+
+template <typename T>
+std::span<const T> view_array(std::span<const std::byte> bytes, std::size_t offset,
+    std::size_t count) {
+  return {reinterpret_cast<const T*>(bytes.data() + offset), count};
+}
+
+}  // namespace
+
+DataFormat DataSource::format_for(const std::filesystem::path& path) {
+  const std::filesystem::path extension = path.extension();
+  if (extension == ".f32") {
+    return DataFormat::Float32;
+  }
+  if (extension == ".f64" || extension == ".bin") {
+    return DataFormat::Float64;
+  }
+  return DataFormat::Csv;
+}
+
+std::unique_ptr<DataSeries> DataSeries::load(const DataSource& source) {
+  APP_PROFILE_FUNCTION();
+
+  // The constructor is private, so std::make_unique cannot be used
+  std::unique_ptr<DataSeries> series(new DataSeries());
+  if (series->map_pyramid(source)) {
+    return series;
+  }
+
+  // Starts over, which also unmaps a stale pyramid so it can be replaced
+  series.reset(new DataSeries());
+  const auto start = std::chrono::steady_clock::now();
+  if (!series->build_pyramid(source)) {
+    return nullptr;
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  APP_INFO("Built the pyramid of {} ({} samples) in {:.2f} ms",
+      source.path.string(),
+      series->size(),
+      elapsed.count());
+
+  // Reading the persisted pyramid back through a mapping lets the OS page it out again
+  if (series->write_pyramid(source)) {
+    std::unique_ptr<DataSeries> persisted(new DataSeries());
+    if (persisted->map_pyramid(source)) {
+      return persisted;
+    }
+  }
+  APP_WARN("Could not persist the pyramid of {}, it is kept in memory", source.path.string());
+  return series;
+}
+
+std::filesystem::path DataSeries::pyramid_path(const std::filesystem::path& path) {
+  std::filesystem::path pyramid = path;
+  pyramid += ".lod";
+  return pyramid;
+}
+
+double DataSeries::x(std::size_t index) const {
+  return m_x.empty() ? static_cast<double>(index) : m_x[index];
+}
+
+double DataSeries::y(std::size_t index) const {
+  return m_y32.empty() ? m_y64[index] : static_cast<double>(m_y32[index]);
+}
+
+std::size_t DataSeries::bucket_size(std::size_t level) {
+  std::size_t size = 1;
+  for (std::size_t i = 0; i < level; ++i) {
+    size *= fan_out;
+  }
+  return size;
+}
+
+void BucketStrokes::add(const DataBucket& extremes, float x_first, float x_last) {
+  if (!(extremes.y_min <= extremes.y_max)) {
+    m_out.end_strip();
+    return;
+  }
+
+  if (m_at_max) {
+    m_out.add_point(ImVec2(x_first, extremes.y_max));
+    m_out.add_point(ImVec2(x_last, extremes.y_min));
+  } else {
+    m_out.add_point(ImVec2(x_first, extremes.y_min));
+    m_out.add_point(ImVec2(x_last, extremes.y_max));
+  }
+  m_at_max = !m_at_max;
+}
+
+std::size_t DataSeries::visible(const DataWindow& window, Polylines& out) const {
+  APP_PROFILE_FUNCTION();
+
+  if (m_size == 0 || !(window.x_scale > 0.0) || !(window.pixels > 0.0)) {
+    return 0;
+  }
+
+  const auto [first, last] = sample_range((window.x_min - window.x_offset) / window.x_scale,
+      (window.x_max - window.x_offset) / window.x_scale);
+  if (first >= last) {
+    return 0;
+  }
+
+  const auto world_x = [this, &window](std::size_t index) {
+    return static_cast<float>(window.x_offset + window.x_scale * x(index));
+  };
+
+  // The coarsest level that still has at least one bucket per pixel
+  const double samples_per_pixel = static_cast<double>(last - first) / window.pixels;
+  std::size_t level = 0;
+  while (level < m_levels.size() &&
+         static_cast<double>(bucket_size(level + 1)) <= samples_per_pixel) {
+    ++level;
+  }
+
+  if (level == 0) {
+    for (std::size_t i = first; i < last; ++i) {
+      const double value = y(i);
+      if (std::isfinite(value)) {
+        out.add_point(ImVec2(world_x(i), static_cast<float>(value)));
+      } else {
+        out.end_strip();
+      }
+    }
+    out.end_strip();
+    return level;
+  }
+
+  const std::size_t size = bucket_size(level);
+  const std::span<const DataBucket> buckets = m_levels[level - 1];
+  BucketStrokes strokes(out);
+  for (std::size_t bucket = first / size; bucket <= (last - 1) / size; ++bucket) {
+    strokes.add(buckets[bucket],
+        world_x(bucket * size),
+        world_x(std::min((bucket + 1) * size, m_size) - 1));
+  }
+  out.end_strip();
+  return level;
+}
+
+std::pair<std::size_t, std::size_t> DataSeries::sample_range(double x_min, double x_max) const {
+  if (!(x_min <= x_max)) {
+    return {0, 0};
+  }
+
+  if (m_x.empty()) {
+    // x is the index; clamping first keeps far away windows representable
+    const auto size = static_cast<double>(m_size);
+    const double first = std::clamp(std::ceil(x_min) - 1.0, 0.0, size);
+    const double last = std::clamp(std::floor(x_max) + 2.0, 0.0, size);
+    return {static_cast<std::size_t>(first), static_cast<std::size_t>(last)};
+  }
+
+  auto first = static_cast<std::size_t>(
+      std::lower_bound(m_x.begin(), m_x.end(), x_min) - m_x.begin());
+  auto last = static_cast<std::size_t>(
+      std::upper_bound(m_x.begin(), m_x.end(), x_max) - m_x.begin());
+  if (first > 0) {
+    --first;
+  }
+  if (last < m_size) {
+    ++last;
+  }
+  return {first, last};
+}
+
+bool DataSeries::map_pyramid(const DataSource& source) {
+  APP_PROFILE_FUNCTION();
+
+  const auto source_stamp = stamp(source.path);
+  const std::filesystem::path path = pyramid_path(source.path);
+  std::error_code error;
+  if (!source_stamp || !std::filesystem::exists(path, error)) {
+    return false;
+  }
+
+  m_pyramid = std::make_unique<MappedFile>(path);
+  const std::span<const std::byte> bytes = m_pyramid->bytes();
+  PyramidHeader header;
+  if (bytes.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  // Anything else is the pyramid of an older version of the file
+  const std::vector<std::size_t> sizes = level_sizes(header.sample_count);
+  if (header.magic != pyramid_magic || header.source_size != source_stamp->size ||
+      header.source_time != source_stamp->time ||
+      header.format != static_cast<std::uint32_t>(source.format) ||
+      header.level_count != sizes.size()) {
+    return false;
+  }
+
+  const auto count = static_cast<std::size_t>(header.sample_count);
+  const bool csv = source.format == DataFormat::Csv;
+  const std::size_t columns = csv ? (header.has_x != 0 ? 2 : 1) : 0;
+  std::size_t expected = sizeof(header) + columns * count * sizeof(double);
+  for (const std::size_t size : sizes) {
+    expected += size * sizeof(DataBucket);
+  }
+  if (bytes.size() != expected) {
+    return false;
+  }
+
+  std::size_t offset = sizeof(header);
+  if (columns == 2) {
+    m_x = view_array<double>(bytes, offset, count);
+    offset += count * sizeof(double);
+  }
+  if (columns > 0) {
+    m_y64 = view_array<double>(bytes, offset, count);
+    offset += count * sizeof(double);
+  }
+  for (const std::size_t size : sizes) {
+    m_levels.push_back(view_array<DataBucket>(bytes, offset, size));
+    offset += size * sizeof(DataBucket);
+  }
+  m_size = count;
+
+  if (!csv) {
+    const std::size_t value_size =
+        source.format == DataFormat::Float32 ? sizeof(float) : sizeof(double);
+    m_source = std::make_unique<MappedFile>(source.path);
+    if (!m_source->valid() || m_source->bytes().size() != count * value_size) {
+      return false;
+    }
+    if (source.format == DataFormat::Float32) {
+      m_y32 = view_array<float>(m_source->bytes(), 0, count);
+    } else {
+      m_y64 = view_array<double>(m_source->bytes(), 0, count);
+    }
+  }
+
+  return true;
+}
+
+bool DataSeries::build_pyramid(const DataSource& source) {
+  APP_PROFILE_FUNCTION();
+
+  m_source = std::make_unique<MappedFile>(source.path);
+  if (!m_source->valid()) {
+    return false;
+  }
+  const std::span<const std::byte> bytes = m_source->bytes();
+
+  switch (source.format) {
+    case DataFormat::Csv: {
+      const std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+      if (!parse_csv(text, source.path, m_owned_x, m_owned_y)) {
+        return false;
+      }
+      m_x = m_owned_x;
+      m_y64 = m_owned_y;
+      m_size = m_owned_y.size();
+      // Everything needed is parsed
+      m_source.reset();
+      break;
+    }
+    case DataFormat::Float32:
+    case DataFormat::Float64: {
+      const std::size_t value_size =
+          source.format == DataFormat::Float32 ? sizeof(float) : sizeof(double);
+      if (bytes.size() % value_size != 0) {
+        APP_ERROR("{} is not a whole number of {}-byte values", source.path.string(), value_size);
+        return false;
+      }
+      m_size = bytes.size() / value_size;
+      if (source.format == DataFormat::Float32) {
+        m_y32 = view_array<float>(bytes, 0, m_size);
+      } else {
+        m_y64 = view_array<double>(bytes, 0, m_size);
+      }
+      break;
+    }
+  }
+
+  build_levels();
+  return true;
+}
+
+void DataSeries::build_levels() {
+  APP_PROFILE_FUNCTION();
+
+  m_owned_levels.clear();
+  m_levels.clear();
+  for (const std::size_t size : level_sizes(m_size)) {
+    std::vector<DataBucket> level(size);
+    if (!m_owned_levels.empty()) {
+      reduce_buckets(m_owned_levels.back(), level);
+    } else if (!m_y32.empty()) {
+      reduce_samples(m_y32, std::span<DataBucket>(level));
+    } else {
+      reduce_samples(m_y64, std::span<DataBucket>(level));
+    }
+    m_owned_levels.push_back(std::move(level));
+  }
+
+  for (const std::vector<DataBucket>& level : m_owned_levels) {
+    m_levels.emplace_back(level);
+  }
+}
+
+bool DataSeries::write_pyramid(const DataSource& source) const {
+  APP_PROFILE_FUNCTION();
+
+  const auto source_stamp = stamp(source.path);
+  if (!source_stamp) {
+    return false;
+  }
+
+  PyramidHeader header;
+  header.magic = pyramid_magic;
+  header.source_size = source_stamp->size;
+  header.source_time = source_stamp->time;
+  header.sample_count = m_size;
+  header.format = static_cast<std::uint32_t>(source.format);
+  header.has_x = m_x.empty() ? 0U : 1U;
+  header.level_count = m_levels.size();
+
+  // Written next to the final file and renamed, so a partial pyramid is never picked up
+  const std::filesystem::path path = pyramid_path(source.path);
+  std::filesystem::path temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+
+    write_array(file, std::span<const PyramidHeader>(&header, 1));
+    if (source.format == DataFormat::Csv) {
+      write_array(file, m_x);
+      write_array(file, m_y64);
+    }
+    for (const std::span<const DataBucket> level : m_levels) {
+      write_array(file, level);
+    }
+
+    if (!file) {
+      file.close();
+      std::error_code error;
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Core/MappedFile.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+// CSV files hold one row per sample, either "y" or "x,y" with x never decreasing; a first
+// row that is not numeric is taken as a header. Binary files are a single column of
+// native-endian y values.
+enum class DataFormat : std::uint8_t { Csv, Float32, Float64 };
+
+struct DataSource {
+  std::filesystem::path path;
+  DataFormat format{DataFormat::Csv};
+
+  // .f32 for floats, .f64 and .bin for doubles, CSV otherwise.
+  [[nodiscard]] static DataFormat format_for(const std::filesystem::path& path);
+};
+
+// The smallest and largest finite y of a run of samples; y_min > y_max when the run
+// has no finite value at all.
+struct DataBucket {
+  float y_min;
+  float y_max;
+};
+
+// Appends min/max buckets to polylines, each as a stroke between its extremes. Starting
+// from the one the previous bucket ended on keeps the strokes from crossing each other.
+// A bucket without finite values breaks the strip; the caller closes the last one.
+class BucketStrokes {
+ public:
+  explicit BucketStrokes(Polylines& out) : m_out(out) {}
+
+  // A bucket whose samples span world x in [x_first, x_last]
+  void add(const DataBucket& extremes, float x_first, float x_last);
+
+ private:
+  Polylines& m_out;
+  bool m_at_max{false};
+};
+
+// The part of a series to show: world x in [x_min, x_max] spans `pixels` screen pixels.
+// A sample's world x is x_offset + x_scale * its file x, where the file x of binary
+// files and single-column CSVs is the sample's index.
+struct DataWindow {
+  double x_min{0.0};
+  double x_max{1.0};
+  double pixels{1.0};
+  double x_offset{0.0};
+  double x_scale{1.0};
+};
+
+// A measured series of up to billions of samples, read through memory mapping. Level k
+// of its min/max pyramid summarizes runs of fan_out^k samples, so any window is drawn
+// from the coarsest level with at least one bucket per pixel: a frame costs about the
+// same whatever the number of samples.
+//
+// The pyramid is built once and persisted to "<file>.lod", which is used instead as long
+// as the file's size and modification time match. For CSV files it holds the parsed
+// columns too, so they are only parsed once.
+class DataSeries {
+ public:
+  static constexpr std::size_t fan_out = 8;
+
+  // Logs the reason and returns nothing when the file cannot be read.
+  [[nodiscard]] static std::unique_ptr<DataSeries> load(const DataSource& source);
+  [[nodiscard]] static std::filesystem::path pyramid_path(const std::filesystem::path& path);
+
+  DataSeries(const DataSeries&) = delete;
+  DataSeries(DataSeries&&) = delete;
+  DataSeries& operator=(DataSeries other) = delete;
+  DataSeries& operator=(DataSeries&& other) = delete;
+  ~DataSeries() = default;
+
+  [[nodiscard]] std::size_t size() const {
+    return m_size;
+  }
+  // File x and y of a sample
+  [[nodiscard]] double x(std::size_t index) const;
+  [[nodiscard]] double y(std::size_t index) const;
+
+  // Levels above the raw samples, which are level 0.
+  [[nodiscard]] std::size_t level_count() const {
+    return m_levels.size();
+  }
+  [[nodiscard]] std::span<const DataBucket> level(std::size_t level) const {
+    return m_levels[level - 1];
+  }
+  [[nodiscard]] static std::size_t bucket_size(std::size_t level);
+
+  // Appends the samples within `window`, plus one on either side, to `out` as world-space
+  // polylines whose x never decreases. Breaks strips where y is not finite. Returns the
+  // level drawn from.
+  std::size_t visible(const DataWindow& window, Polylines& out) const;
+
+ private:
+  DataSeries() = default;
+
+  bool map_pyramid(const DataSource& source);
+  bool build_pyramid(const DataSource& source);
+  bool write_pyramid(const DataSource& source) const;
+  void build_levels();
+
+  // [first, last) of the samples whose file x lies within [x_min, x_max], widened by one
+  std::pair<std::size_t, std::size_t> sample_range(double x_min, double x_max) const;
+
+  std::unique_ptr<MappedFile> m_source;
+  std::unique_ptr<MappedFile> m_pyramid;
+  std::size_t m_size{0};
+
+  // Views into the mapped files, or into the owned vectors while the pyramid is not
+  // persisted. An empty x column means x is the sample index.
+  std::span<const double> m_x;
+  std::span<const float> m_y32;
+  std::span<const double> m_y64;
+  std::vector<std::span<const DataBucket>> m_levels;
+
+  std::vector<double> m_owned_x;
+  std::vector<double> m_owned_y;
+  std::vector<std::vector<DataBucket>> m_owned_levels;
+};
+
+}  // namespace App::Plot
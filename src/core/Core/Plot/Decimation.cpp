@@ -0,0 +1,159 @@
+#include "Decimation.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Screen pixels a simplified curve may deviate from its samples, well below the
+// thickness curves are drawn with
+constexpr float simplify_tolerance = 0.5F;
+
+float distance_squared_to_segment(const ImVec2& point, const ImVec2& a, const ImVec2& b) {
+  const float dx = b.x - a.x;
+  const float dy = b.y - a.y;
+  const float length_squared = dx * dx + dy * dy;
+
+  float t = 0.0F;
+  if (length_squared > 0.0F) {
+    t = std::clamp(((point.x - a.x) * dx + (point.y - a.y) * dy) / length_squared, 0.0F, 1.0F);
+  }
+  const float ex = point.x - (a.x + t * dx);
+  const float ey = point.y - (a.y + t * dy);
+  return ex * ex + ey * ey;
+}
+
+}  // namespace
+
+void draw_world_polylines(ImDrawList* draw_list,
+    const Polylines& polylines,
+    const ImVec2& origin,
+    float zoom,
+    ImU32 color,
+    float thickness,
+    bool x_monotonic,
+    PolylineDecimator& decimator,
+    FrameArena& scratch) {
+  // Screen-space points of one strip at a time, valid until the arena is reset
+  const ArenaAllocator<ImVec2> allocator(scratch);
+  ArenaVector<ImVec2> screen_points(allocator);
+  ArenaVector<ImVec2> decimated_points(allocator);
+  screen_points.reserve(polylines.longest_strip());
+  decimated_points.reserve(polylines.longest_strip());
+
+  for (std::size_t i = 0; i < polylines.strip_count(); ++i) {
+    const std::span<const ImVec2> strip = polylines.strip(i);
+    screen_points.resize(strip.size());
+    for (std::size_t j = 0; j < strip.size(); ++j) {
+      screen_points[j] = ImVec2(origin.x + strip[j].x * zoom, origin.y - strip[j].y * zoom);
+    }
+
+    decimated_points.clear();
+    if (x_monotonic) {
+      decimator.reduce_columns(screen_points, decimated_points);
+    } else {
+      decimator.simplify(screen_points, simplify_tolerance, decimated_points);
+    }
+
+    draw_list->AddPolyline(decimated_points.data(),
+        static_cast<int>(decimated_points.size()),
+        color,
+        ImDrawFlags_None,
+        thickness);
+  }
+}
+
+std::size_t PolylineDecimator::write_column_extremes(std::span<const ImVec2> strip,
+    std::span<ImVec2> out) {
+  std::size_t count = 0;
+  std::size_t first = 0;
+  while (first < strip.size()) {
+    const float column = std::floor(strip[first].x);
+
+    std::size_t lowest = first;
+    std::size_t highest = first;
+    std::size_t end = first + 1;
+    for (; end < strip.size() && std::floor(strip[end].x) == column; ++end) {
+      if (strip[end].y < strip[lowest].y) {
+        lowest = end;
+      }
+      if (strip[end].y > strip[highest].y) {
+        highest = end;
+      }
+    }
+
+    std::array<std::size_t, 4> picks{first, lowest, highest, end - 1};
+    std::sort(picks.begin(), picks.end());
+    const auto picked = std::unique(picks.begin(), picks.end());
+    for (auto pick = picks.begin(); pick != picked; ++pick) {
+      out[count++] = strip[*pick];
+    }
+
+    first = end;
+  }
+
+  return count;
+}
+
+std::size_t PolylineDecimator::write_simplified(std::span<const ImVec2> strip,
+    float tolerance,
+    std::span<ImVec2> out) {
+  // Strips this short are kept whole
+  m_keep.assign(strip.size(), 1);
+  if (strip.size() >= 3) {
+    mark_simplified(strip, tolerance);
+  }
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < strip.size(); ++i) {
+    if (m_keep[i] != 0) {
+      out[count++] = strip[i];
+    }
+  }
+  return count;
+}
+
+void PolylineDecimator::mark_simplified(std::span<const ImVec2> strip, float tolerance) {
+  const auto last = static_cast<std::uint32_t>(strip.size() - 1);
+  std::fill(m_keep.begin() + 1, m_keep.end() - 1, 0);
+
+  // An explicit stack of index ranges still to split, so long strips cannot overflow
+  // the call stack
+  const float tolerance_squared = tolerance * tolerance;
+  m_ranges.clear();
+  m_ranges.emplace_back(0U, last);
+  while (!m_ranges.empty()) {
+    const auto [a, b] = m_ranges.back();
+    m_ranges.pop_back();
+
+    float farthest = tolerance_squared;
+    std::uint32_t split = a;
+    for (std::uint32_t i = a + 1; i < b; ++i) {
+      const float distance = distance_squared_to_segment(strip[i], strip[a], strip[b]);
+      if (distance > farthest) {
+        farthest = distance;
+        split = i;
+      }
+    }
+
+    if (split != a) {
+      m_keep[split] = 1;
+      m_ranges.emplace_back(a, split);
+      m_ranges.emplace_back(split, b);
+    }
+  }
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+// Thins out screen-space polylines before they are handed to ImDrawList::AddPolyline,
+// which tessellates every segment into a thick-line quad however short it is. The
+// results keep about as many vertices as the strip is long on screen, rather than as
+// many as it was sampled with. Scratch buffers are kept between calls. Neither method
+// appends more points than the strip has, so an `out` with that much spare capacity is
+// never reallocated. `out` may use any allocator, e.g. an ArenaVector of frame scratch.
+class PolylineDecimator {
+ public:
+  // Reduces a strip whose x never decreases, e.g. the graph of y = f(x), to the first,
+  // lowest, highest and last point of every pixel column, in their original order. Every
+  // column keeps its vertical extent, so spikes narrower than a pixel still show.
+  // Appends at most four points per column to `out` and returns how many.
+  template <typename Allocator>
+  std::size_t reduce_columns(std::span<const ImVec2> strip,
+      std::vector<ImVec2, Allocator>& out) {
+    const std::size_t initial_size = out.size();
+    out.resize(initial_size + strip.size());
+    const std::size_t count = write_column_extremes(strip, std::span(out).subspan(initial_size));
+    out.resize(initial_size + count);
+    return count;
+  }
+
+  // Douglas-Peucker simplification of any strip, e.g. a parametric or polar curve: drops
+  // the points that are within `tolerance` pixels of the simplified strip. The first and
+  // last points are always kept. Appends to `out` and returns the number of points.
+  template <typename Allocator>
+  std::size_t simplify(std::span<const ImVec2> strip,
+      float tolerance,
+      std::vector<ImVec2, Allocator>& out) {
+    const std::size_t initial_size = out.size();
+    out.resize(initial_size + strip.size());
+    const std::size_t count =
+        write_simplified(strip, tolerance, std::span(out).subspan(initial_size));
+    out.resize(initial_size + count);
+    return count;
+  }
+
+ private:
+  // The cores of the methods above, writing to the front of `out`, which has room for
+  // every point of the strip.
+  static std::size_t write_column_extremes(std::span<const ImVec2> strip,
+      std::span<ImVec2> out);
+  std::size_t write_simplified(std::span<const ImVec2> strip,
+      float tolerance,
+      std::span<ImVec2> out);
+  // Clears the marks in m_keep of the points a strip of at least three drops
+  void mark_simplified(std::span<const ImVec2> strip, float tolerance);
+
+  std::vector<std::uint8_t> m_keep;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> m_ranges;
+};
+
+// Draws world-space polylines at `origin` and `zoom`, each strip decimated on screen
+// first: by pixel columns when x never decreases, e.g. y = f(x) or a data series, and by
+// simplification otherwise. Screen-space points are taken from `scratch`.
+void draw_world_polylines(ImDrawList* draw_list,
+    const Polylines& polylines,
+    const ImVec2& origin,
+    float zoom,
+    ImU32 color,
+    float thickness,
+    bool x_monotonic,
+    PolylineDecimator& decimator,
+    FrameArena& scratch);
+
+}  // namespace App::Plot
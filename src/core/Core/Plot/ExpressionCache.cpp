@@ -0,0 +1,279 @@
+#include "ExpressionCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/Debug/FrameStats.hpp"
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/SharedSymbols.hpp"
+#include "exprtk.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// ExpressionTree is only trusted when it reproduces exprtk's values; a difference in
+// precedence or function semantics would otherwise let the tree's consumers prune away
+// parts of the curve exprtk draws, or draw a different one.
+bool matches_exprtk(const ExpressionTree& tree,
+    exprtk::expression<double>& expression,
+    std::span<double* const> variables) {
+  static constexpr std::array<std::array<double, 2>, 6> probes{{
+      {0.37, -1.21},
+      {-2.3, 0.8},
+      {1.7, 2.9},
+      {-0.61, -0.45},
+      {3.1, -2.2},
+      {0.05, 0.11},
+  }};
+
+  std::vector<double> values(variables.size());
+  std::vector<double> scratch;
+  for (const auto& probe : probes) {
+    // Parameters beyond the first two variables get shifted copies of the probe
+    for (std::size_t v = 0; v < variables.size(); ++v) {
+      values[v] = probe[v % probe.size()] + 0.5 * static_cast<double>(v / probe.size());
+      *variables[v] = values[v];
+    }
+    const double expected = expression.value();
+    const double actual = tree.evaluate(values, scratch);
+
+    if (std::isnan(expected) != std::isnan(actual)) {
+      return false;
+    }
+    if (!std::isnan(expected) &&
+        std::abs(expected - actual) > 1.0e-9 * std::max(1.0, std::abs(expected))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The analysable form of an expression exprtk has already compiled, if there is one.
+std::optional<ExpressionTree> analyse(std::string_view text,
+    exprtk::expression<double>& expression,
+    std::span<const std::string_view> names,
+    std::span<double* const> variables) {
+  auto tree = ExpressionTree::parse(text, names);
+  if (tree && !matches_exprtk(*tree, expression, variables)) {
+    tree.reset();
+  }
+  return tree;
+}
+
+std::optional<BatchProgram> lower(const std::optional<ExpressionTree>& tree) {
+  if (!tree) {
+    return std::nullopt;
+  }
+  return BatchProgram::compile(*tree);
+}
+
+// Where the values of mode_variables(plot.mode) are stored
+std::array<double*, 2> variable_slots(CompiledPlot& plot) {
+  switch (plot.mode) {
+    case PlotMode::Parametric:
+      return {&plot.t, nullptr};
+    case PlotMode::Polar:
+      return {&plot.theta, nullptr};
+    case PlotMode::Inequality:
+    case PlotMode::Implicit:
+    case PlotMode::Explicit:
+    case PlotMode::None:
+      break;
+  }
+  return {&plot.x, &plot.y};
+}
+
+std::optional<ExpressionTree> bind(const std::optional<ExpressionTree>& source,
+    std::span<const double> values) {
+  if (!source) {
+    return std::nullopt;
+  }
+  return source->bind(values);
+}
+
+// The split form of a curve expression, when it has a part that reads no parameter
+std::optional<CurveProgram> split_curve(const std::optional<ExpressionTree>& source,
+    std::size_t parameter_count) {
+  if (!source || parameter_count == 0) {
+    return std::nullopt;
+  }
+  SplitTree split = source->split(parameter_count);
+  if (split.invariants.empty()) {
+    return std::nullopt;
+  }
+
+  CurveProgram curve;
+  for (const ExpressionTree& invariant : split.invariants) {
+    curve.invariants.push_back(BatchProgram::compile(invariant));
+  }
+  curve.residual = std::move(split.residual);
+  return curve;
+}
+
+// Binds the analysable forms of `plot` to its parameter values
+void bind_parameters(CompiledPlot& plot) {
+  const std::span<const double> values = plot.parameters;
+  plot.primary_tree = bind(plot.primary_source, values);
+  plot.primary_batch = lower(plot.primary_tree);
+  plot.secondary_batch = lower(bind(plot.secondary_source, values));
+  for (std::optional<CurveProgram>* curve : {&plot.primary_curve, &plot.secondary_curve}) {
+    if (*curve) {
+      (*curve)->bound = BatchProgram::compile((*curve)->residual.bind(values));
+    }
+  }
+}
+
+// Registers the plot's own variables, and the shared constants and functions by
+// reference. Call with the shared symbols' lock held.
+std::unique_ptr<CompiledPlot> make_plot(PlotMode mode) {
+  auto plot = std::make_unique<CompiledPlot>();
+  plot->mode = mode;
+  for (exprtk::expression<double>* expression : {&plot->primary, &plot->secondary}) {
+    expression->register_symbol_table(plot->symbols);
+    SharedSymbols::get().register_with(*expression);
+  }
+  return plot;
+}
+
+}  // namespace
+
+ExpressionCache::ExpressionCache()
+    : m_parser(std::make_unique<exprtk::parser<double>>()),
+      m_compiled(std::make_unique<CompiledPlot>()) {}
+
+ExpressionCache::~ExpressionCache() {
+  // The parser and the plots hold references to the shared symbols
+  const std::unique_lock lock = SharedSymbols::get().lock();
+  m_parser.reset();
+  m_compiled.reset();
+  m_copies.clear();
+}
+
+CompiledPlot& ExpressionCache::get(const std::string& text) {
+  if (text == m_text) {
+    return *m_compiled;
+  }
+
+  APP_PROFILE_STAGE(Debug::Stage::Compile, "ExpressionCache::compile");
+
+  m_description = describe_plot(text);
+  m_parameters.assign(m_description.parameters.size(), default_parameter_value);
+  std::unique_ptr<CompiledPlot> compiled = compile();
+  {
+    // Dropping the old plots releases their references to the shared symbols
+    const std::unique_lock lock = SharedSymbols::get().lock();
+    m_compiled = std::move(compiled);
+    m_copies.clear();
+  }
+  m_instances.clear();
+  m_text = text;
+  ++m_revision;
+  ++m_compiled_revision;
+
+  return *m_compiled;
+}
+
+CompiledPlot& ExpressionCache::current() {
+  return *m_compiled;
+}
+
+std::span<CompiledPlot* const> ExpressionCache::instances(std::size_t count) {
+  if (m_instances.empty()) {
+    m_instances.push_back(m_compiled.get());
+  }
+
+  if (m_instances.size() < count) {
+    APP_PROFILE_SCOPE("ExpressionCache::compile_instances");
+
+    while (m_instances.size() < count) {
+      m_copies.push_back(compile());
+      m_instances.push_back(m_copies.back().get());
+    }
+  }
+
+  return {m_instances.data(), count};
+}
+
+std::uint64_t ExpressionCache::revision() const {
+  return m_revision;
+}
+
+void ExpressionCache::set_parameters(std::span<const double> values) {
+  if (values.size() != m_parameters.size() ||
+      std::equal(values.begin(), values.end(), m_parameters.begin())) {
+    return;
+  }
+
+  APP_PROFILE_FUNCTION();
+
+  m_parameters.assign(values.begin(), values.end());
+  const auto update = [this](CompiledPlot& plot) {
+    // A plot that failed to compile has no parameters
+    if (plot.parameters.size() == m_parameters.size()) {
+      std::copy(m_parameters.begin(), m_parameters.end(), plot.parameters.begin());
+      bind_parameters(plot);
+    }
+  };
+  update(*m_compiled);
+  for (const auto& copy : m_copies) {
+    update(*copy);
+  }
+  ++m_revision;
+}
+
+std::unique_ptr<CompiledPlot> ExpressionCache::compile() {
+  const PlotMode mode = m_description.mode;
+  if (mode == PlotMode::None) {
+    return std::make_unique<CompiledPlot>();
+  }
+
+  // Held until the plot is returned or, when it does not compile, destroyed
+  const std::unique_lock lock = SharedSymbols::get().lock();
+  auto plot = make_plot(mode);
+  const std::span<const std::string_view> mode_names = mode_variables(mode);
+  const std::array<double*, 2> mode_slots = variable_slots(*plot);
+
+  // The mode's variables, then the parameters
+  std::vector<std::string_view> names(mode_names.begin(), mode_names.end());
+  std::vector<double*> variables(mode_slots.begin(), mode_slots.begin() + mode_names.size());
+  plot->parameters = m_parameters;
+  for (std::size_t i = 0; i < m_description.parameters.size(); ++i) {
+    names.emplace_back(m_description.parameters[i]);
+    variables.push_back(&plot->parameters[i]);
+  }
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    plot->symbols.add_variable(std::string{names[i]}, *variables[i]);
+  }
+
+  const bool parametric = mode == PlotMode::Parametric;
+  if (!m_parser->compile(m_description.primary, plot->primary) ||
+      (parametric && !m_parser->compile(m_description.secondary, plot->secondary))) {
+    return std::make_unique<CompiledPlot>();
+  }
+
+  plot->primary_source = analyse(m_description.primary, plot->primary, names, variables);
+  if (parametric) {
+    plot->secondary_source =
+        analyse(m_description.secondary, plot->secondary, names, variables);
+  }
+  // The probes overwrote the parameter values
+  std::copy(m_parameters.begin(), m_parameters.end(), plot->parameters.begin());
+
+  if (mode == PlotMode::Parametric || mode == PlotMode::Polar) {
+    plot->primary_curve = split_curve(plot->primary_source, m_parameters.size());
+    plot->secondary_curve = split_curve(plot->secondary_source, m_parameters.size());
+  }
+  bind_parameters(*plot);
+  return plot;
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Core/Plot/BatchProgram.hpp"
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/PlotDescription.hpp"
+#include "exprtk.hpp"
+
+namespace App::Plot {
+
+// A curve expression split into the parts that read no parameter and the rest, so a curve
+// whose parameters changed only evaluates the rest at its fixed samples.
+struct CurveProgram {
+  // Batch forms of SplitTree::invariants, in the curve variable
+  std::vector<BatchProgram> invariants;
+  // The residual in the curve variable, the invariants' values and the parameters
+  ExpressionTree residual;
+  // `residual` bound to the current parameter values
+  BatchProgram bound;
+};
+
+// The parsed expression(s) for one input text together with the variables they are
+// bound to. Always heap allocated so the addresses registered in `symbols` stay valid.
+// The expressions also read SharedSymbols, so a plot that compiled must be destroyed with
+// its lock held.
+struct CompiledPlot {
+  PlotMode mode{PlotMode::None};
+
+  double x{0.0};
+  double y{0.0};
+  double t{0.0};
+  double theta{0.0};
+  // Values of PlotDescription::parameters. Registered with `symbols`, so the vector is
+  // sized once and never resized.
+  std::vector<double> parameters;
+
+  // The plot's own variables; constants and functions come from SharedSymbols
+  exprtk::symbol_table<double> symbols;
+  // f(x), r(theta), x(t), the inequality or lhs - rhs of an implicit equation
+  exprtk::expression<double> primary;
+  // y(t) of a parametric curve, unused by the other modes
+  exprtk::expression<double> secondary;
+
+  // `primary` and `secondary` in analysable form, when they stay within ExpressionTree's
+  // subset. Their variables are those of the mode in order, x and y, x, t or theta,
+  // followed by the parameters.
+  std::optional<ExpressionTree> primary_source;
+  std::optional<ExpressionTree> secondary_source;
+
+  // `primary_source` with the current parameter values bound, so its variables are only
+  // those of the mode.
+  std::optional<ExpressionTree> primary_tree;
+
+  // Batch forms of primary and secondary for the bulk sampling paths, with the current
+  // parameter values bound. Empty when the expression is outside ExpressionTree's subset;
+  // exprtk evaluates it point by point then.
+  std::optional<BatchProgram> primary_batch;
+  std::optional<BatchProgram> secondary_batch;
+
+  // Split forms of the curve modes, when a part reading no parameter was found
+  std::optional<CurveProgram> primary_curve;
+  std::optional<CurveProgram> secondary_curve;
+};
+
+// Keeps the compiled form of the last expression text. The text is described and compiled
+// only when it changes; `revision()` is bumped every time it is, and every time the
+// parameter values change, so callers can tell whether anything derived from the old
+// expression is stale.
+//
+// Parameters are exprtk variables, so new values need no compilation: exprtk reads them in
+// place and only the analysable forms are bound to them again.
+//
+// exprtk expressions read their variables through the symbol table, so one compiled plot
+// can only be evaluated by one thread at a time. `instances()` hands out independent
+// copies of the current plot for parallel evaluation.
+class ExpressionCache {
+ public:
+  ExpressionCache();
+  ~ExpressionCache();
+
+  ExpressionCache(const ExpressionCache&) = delete;
+  ExpressionCache(ExpressionCache&&) = delete;
+  ExpressionCache& operator=(ExpressionCache other) = delete;
+  ExpressionCache& operator=(ExpressionCache&& other) = delete;
+
+  CompiledPlot& get(const std::string& text);
+  [[nodiscard]] CompiledPlot& current();
+  [[nodiscard]] const PlotDescription& description() const {
+    return m_description;
+  }
+  [[nodiscard]] std::uint64_t revision() const;
+  // Bumped only when the text is compiled again, so results that do not depend on the
+  // parameter values can be kept while they change.
+  [[nodiscard]] std::uint64_t compiled_revision() const {
+    return m_compiled_revision;
+  }
+
+  // Sets the values of description().parameters, in order. Values for a different
+  // number of parameters belong to another text and are ignored.
+  void set_parameters(std::span<const double> values);
+  // `count` separately compiled copies of the current plot, the first being current().
+  // Copies are compiled on the calling thread the first time they are asked for and kept
+  // until the text changes.
+  [[nodiscard]] std::span<CompiledPlot* const> instances(std::size_t count);
+
+ private:
+  // Compiles the parts of m_description in the variables of its mode. Returns a plot of
+  // mode None when they do not compile.
+  std::unique_ptr<CompiledPlot> compile();
+
+  // Heap allocated so it can be released under the shared symbols' lock
+  std::unique_ptr<exprtk::parser<double>> m_parser;
+  std::string m_text;
+  PlotDescription m_description;
+  std::unique_ptr<CompiledPlot> m_compiled;
+  std::vector<std::unique_ptr<CompiledPlot>> m_copies;
+  std::vector<CompiledPlot*> m_instances;
+  std::vector<double> m_parameters;
+  std::uint64_t m_revision{0};
+  std::uint64_t m_compiled_revision{0};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,724 @@
+#include "ExpressionTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Core/Plot/Interval.hpp"
+#include "Core/Plot/Tokenizer.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+struct NamedConstant {
+  std::string_view name;
+  double value;
+};
+
+// The constants SharedSymbols provides
+constexpr std::array CONSTANTS{
+    NamedConstant{"pi", std::numbers::pi},
+    NamedConstant{"π", std::numbers::pi},
+    NamedConstant{"e", std::numbers::e},
+    NamedConstant{"phi", std::numbers::phi},
+    NamedConstant{"ϕ", std::numbers::phi},
+    NamedConstant{"φ", std::numbers::phi},
+    NamedConstant{"gamma", std::numbers::egamma},
+    NamedConstant{"γ", std::numbers::egamma},
+    NamedConstant{"epsilon", std::numeric_limits<double>::epsilon()},
+    NamedConstant{"inf", std::numeric_limits<double>::infinity()},
+};
+
+struct NamedFunction {
+  std::string_view name;
+  Op op;
+  int arity;
+};
+
+constexpr std::array FUNCTIONS{
+    NamedFunction{"abs", Op::Abs, 1},
+    NamedFunction{"acos", Op::Acos, 1},
+    NamedFunction{"asin", Op::Asin, 1},
+    NamedFunction{"atan", Op::Atan, 1},
+    NamedFunction{"ceil", Op::Ceil, 1},
+    NamedFunction{"cos", Op::Cos, 1},
+    NamedFunction{"cosh", Op::Cosh, 1},
+    NamedFunction{"cot", Op::Cot, 1},
+    NamedFunction{"csc", Op::Csc, 1},
+    NamedFunction{"exp", Op::Exp, 1},
+    NamedFunction{"floor", Op::Floor, 1},
+    NamedFunction{"ln", Op::Log, 1},
+    NamedFunction{"log", Op::Log, 1},
+    NamedFunction{"log10", Op::Log10, 1},
+    NamedFunction{"log2", Op::Log2, 1},
+    NamedFunction{"round", Op::Round, 1},
+    NamedFunction{"sec", Op::Sec, 1},
+    NamedFunction{"sgn", Op::Sgn, 1},
+    NamedFunction{"sin", Op::Sin, 1},
+    NamedFunction{"sinh", Op::Sinh, 1},
+    NamedFunction{"sqrt", Op::Sqrt, 1},
+    NamedFunction{"tan", Op::Tan, 1},
+    NamedFunction{"tanh", Op::Tanh, 1},
+    NamedFunction{"trunc", Op::Trunc, 1},
+    NamedFunction{"atan2", Op::Atan2, 2},
+    NamedFunction{"hypot", Op::Hypot, 2},
+    NamedFunction{"min", Op::Min, 2},
+    NamedFunction{"max", Op::Max, 2},
+    NamedFunction{"pow", Op::Power, 2},
+};
+
+bool is_unary(Op op) {
+  return op == Op::Negate || (op >= Op::Abs && op <= Op::Trunc);
+}
+
+// Appends `node` to `nodes`, folding it into a constant when its operands are constants.
+// Nodes are in postfix order, so the operands are the most recent nodes and folding can
+// drop them again.
+void append_folded(std::vector<Node>& nodes, Node node) {
+  const bool unary = is_unary(node.op);
+  if (node.op != Op::Constant && node.op != Op::Variable) {
+    const Node& a = nodes[node.lhs];
+    const Node& b = nodes[node.rhs];
+    if (a.op == Op::Constant && (unary || b.op == Op::Constant)) {
+      const double value = ExpressionTree::apply(node.op, a.value, unary ? 0.0 : b.value);
+      nodes.resize(std::min(node.lhs, unary ? node.lhs : node.rhs));
+      node = {Op::Constant, 0, 0, value};
+    }
+  }
+  nodes.push_back(node);
+}
+
+std::string lowercase(std::string_view text) {
+  std::string result{text};
+  std::transform(result.begin(), result.end(), result.begin(), [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return result;
+}
+
+// Recursive descent parser. Precedence from low to high:
+//   or, and, comparisons, + -, * / % and implicit multiplication, unary + -, ^
+class Parser {
+ public:
+  Parser(std::string_view text, std::span<const std::string_view> variables)
+      : m_tokenizer(text),
+        m_variables(variables) {
+    advance();
+  }
+
+  std::optional<std::vector<Node>> parse() {
+    const std::uint32_t root = logical_or();
+    if (m_failed || m_token.kind != TokenKind::End || m_nodes.empty()) {
+      return std::nullopt;
+    }
+    // The root is always the last node added
+    if (root + 1 != m_nodes.size()) {
+      return std::nullopt;
+    }
+    return std::move(m_nodes);
+  }
+
+ private:
+  void advance() {
+    m_token = m_tokenizer.next();
+    if (m_token.kind == TokenKind::Invalid) {
+      m_failed = true;
+    }
+  }
+
+  bool accept(std::string_view symbol) {
+    if (m_token.kind == TokenKind::Symbol && m_token.text == symbol) {
+      advance();
+      return true;
+    }
+    return false;
+  }
+
+  bool accept_keyword(std::string_view keyword) {
+    if (m_token.kind == TokenKind::Identifier && lowercase(m_token.text) == keyword) {
+      advance();
+      return true;
+    }
+    return false;
+  }
+
+  void expect(std::string_view symbol) {
+    if (!accept(symbol)) {
+      m_failed = true;
+    }
+  }
+
+  std::uint32_t fail() {
+    m_failed = true;
+    return 0;
+  }
+
+  std::uint32_t add(Op op, std::uint32_t lhs, std::uint32_t rhs = 0) {
+    if (m_failed) {
+      return 0;
+    }
+
+    append_folded(m_nodes, {op, lhs, rhs, 0.0});
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+  }
+
+  std::uint32_t constant(double value) {
+    m_nodes.push_back({Op::Constant, 0, 0, value});
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+  }
+
+  std::uint32_t logical_or() {
+    std::uint32_t lhs = logical_and();
+    while (!m_failed && (accept("|") || accept_keyword("or"))) {
+      lhs = add(Op::Or, lhs, logical_and());
+    }
+    return lhs;
+  }
+
+  std::uint32_t logical_and() {
+    std::uint32_t lhs = comparison();
+    while (!m_failed && (accept("&") || accept_keyword("and"))) {
+      lhs = add(Op::And, lhs, comparison());
+    }
+    return lhs;
+  }
+
+  std::uint32_t comparison() {
+    std::uint32_t lhs = additive();
+    static constexpr std::array<std::pair<std::string_view, Op>, 8> operators{{
+        {"<=", Op::LessEqual},
+        {">=", Op::GreaterEqual},
+        {"==", Op::Equal},
+        {"!=", Op::NotEqual},
+        {"<>", Op::NotEqual},
+        {"<", Op::Less},
+        {">", Op::Greater},
+        {"=", Op::Equal},
+    }};
+    for (bool matched = true; matched && !m_failed;) {
+      matched = false;
+      for (const auto& [symbol, op] : operators) {
+        if (accept(symbol)) {
+          lhs = add(op, lhs, additive());
+          matched = true;
+          break;
+        }
+      }
+    }
+    return lhs;
+  }
+
+  std::uint32_t additive() {
+    std::uint32_t lhs = term();
+    while (!m_failed) {
+      if (accept("+")) {
+        lhs = add(Op::Add, lhs, term());
+      } else if (accept("-")) {
+        lhs = add(Op::Subtract, lhs, term());
+      } else {
+        break;
+      }
+    }
+    return lhs;
+  }
+
+  [[nodiscard]] bool starts_operand() const {
+    if (m_token.kind == TokenKind::Number) {
+      return true;
+    }
+    if (m_token.kind == TokenKind::Identifier) {
+      const std::string name = lowercase(m_token.text);
+      return name != "and" && name != "or";
+    }
+    return m_token.kind == TokenKind::Symbol &&
+           (m_token.text == "(" || m_token.text == "[" || m_token.text == "{");
+  }
+
+  std::uint32_t term() {
+    std::uint32_t lhs = unary();
+    while (!m_failed) {
+      if (accept("*")) {
+        lhs = add(Op::Multiply, lhs, unary());
+      } else if (accept("/")) {
+        lhs = add(Op::Divide, lhs, unary());
+      } else if (accept("%")) {
+        lhs = add(Op::Modulo, lhs, unary());
+      } else if (starts_operand()) {
+        // Implicit multiplication as in 2x or (x + 1)(x - 1)
+        lhs = add(Op::Multiply, lhs, unary());
+      } else {
+        break;
+      }
+    }
+    return lhs;
+  }
+
+  std::uint32_t unary() {
+    if (accept("-")) {
+      return add(Op::Negate, unary());
+    }
+    if (accept("+")) {
+      return unary();
+    }
+    return power();
+  }
+
+  std::uint32_t power() {
+    const std::uint32_t base = primary();
+    if (!m_failed && (accept("^") || accept("**"))) {
+      // Right associative, and the exponent may carry its own sign: 2^-x^2
+      return add(Op::Power, base, unary());
+    }
+    return base;
+  }
+
+  std::uint32_t group(std::string_view close) {
+    const std::uint32_t inner = logical_or();
+    expect(close);
+    return inner;
+  }
+
+  std::uint32_t primary() {
+    if (m_failed) {
+      return 0;
+    }
+
+    if (m_token.kind == TokenKind::Number) {
+      const double value = m_token.number;
+      advance();
+      return constant(value);
+    }
+    if (accept("(")) {
+      return group(")");
+    }
+    if (accept("[")) {
+      return group("]");
+    }
+    if (accept("{")) {
+      return group("}");
+    }
+    if (m_token.kind != TokenKind::Identifier) {
+      return fail();
+    }
+
+    const std::string name = lowercase(m_token.text);
+    advance();
+
+    if (accept("(")) {
+      return call(name);
+    }
+    for (std::uint32_t i = 0; i < m_variables.size(); ++i) {
+      if (lowercase(m_variables[i]) == name) {
+        m_nodes.push_back({Op::Variable, i, 0, 0.0});
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+      }
+    }
+    for (const NamedConstant& named : CONSTANTS) {
+      if (named.name == name) {
+        return constant(named.value);
+      }
+    }
+    return fail();
+  }
+
+  std::uint32_t call(const std::string& name) {
+    const auto function =
+        std::find_if(FUNCTIONS.begin(), FUNCTIONS.end(), [&name](const NamedFunction& f) {
+          return f.name == name;
+        });
+    if (function == FUNCTIONS.end()) {
+      return fail();
+    }
+
+    const std::uint32_t first = logical_or();
+    if (function->arity == 1) {
+      expect(")");
+      return add(function->op, first);
+    }
+    expect(",");
+    const std::uint32_t second = logical_or();
+    expect(")");
+    return add(function->op, first, second);
+  }
+
+  Tokenizer m_tokenizer;
+  std::span<const std::string_view> m_variables;
+  Token m_token;
+  std::vector<Node> m_nodes;
+  bool m_failed{false};
+};
+
+bool truthy(double value) {
+  return value != 0.0;
+}
+
+bool approximately_equal(double a, double b) {
+  // exprtk compares doubles with a relative epsilon
+  return std::abs(a - b) <= 1.0e-10 * std::max({1.0, std::abs(a), std::abs(b)});
+}
+
+Interval boolean(bool can_be_false, bool can_be_true) {
+  return {can_be_false ? 0.0 : 1.0, can_be_true ? 1.0 : 0.0};
+}
+
+}  // namespace
+
+std::optional<ExpressionTree> ExpressionTree::parse(std::string_view text,
+    std::span<const std::string_view> variables) {
+  Parser parser{text, variables};
+  std::optional<std::vector<Node>> nodes = parser.parse();
+  if (!nodes) {
+    return std::nullopt;
+  }
+
+  ExpressionTree tree;
+  tree.m_nodes = std::move(*nodes);
+  tree.m_variable_count = variables.size();
+  return tree;
+}
+
+double ExpressionTree::evaluate(std::span<const double> variables,
+    std::vector<double>& scratch) const {
+  scratch.resize(m_nodes.size());
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    if (node.op == Op::Constant) {
+      scratch[i] = node.value;
+    } else if (node.op == Op::Variable) {
+      scratch[i] = variables[node.lhs];
+    } else {
+      scratch[i] = apply(node.op, scratch[node.lhs], scratch[node.rhs]);
+    }
+  }
+  return scratch.back();
+}
+
+Interval ExpressionTree::evaluate(std::span<const Interval> variables,
+    std::vector<Interval>& scratch) const {
+  scratch.resize(m_nodes.size());
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    if (node.op == Op::Constant) {
+      scratch[i] = {node.value, node.value};
+    } else if (node.op == Op::Variable) {
+      scratch[i] = variables[node.lhs];
+    } else {
+      scratch[i] = apply(node.op, scratch[node.lhs], scratch[node.rhs]);
+    }
+  }
+  return scratch.back();
+}
+
+bool ExpressionTree::uses_variable(std::uint32_t index) const {
+  return std::any_of(m_nodes.begin(), m_nodes.end(), [index](const Node& node) {
+    return node.op == Op::Variable && node.lhs == index;
+  });
+}
+
+ExpressionTree ExpressionTree::bind(std::span<const double> values) const {
+  const std::size_t first_bound = m_variable_count - values.size();
+
+  ExpressionTree bound;
+  bound.m_variable_count = first_bound;
+  bound.m_nodes.reserve(m_nodes.size());
+  // Where each node ended up; folding shifts the nodes after it
+  std::vector<std::uint32_t> moved(m_nodes.size(), 0);
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    Node node = m_nodes[i];
+    if (node.op == Op::Variable && node.lhs >= first_bound) {
+      node = {Op::Constant, 0, 0, values[node.lhs - first_bound]};
+    } else if (node.op != Op::Constant && node.op != Op::Variable) {
+      node.lhs = moved[node.lhs];
+      node.rhs = is_unary(node.op) ? 0 : moved[node.rhs];
+    }
+    append_folded(bound.m_nodes, node);
+    moved[i] = static_cast<std::uint32_t>(bound.m_nodes.size() - 1);
+  }
+  return bound;
+}
+
+SplitTree ExpressionTree::split(std::size_t parameter_count) const {
+  const std::size_t leading = m_variable_count - parameter_count;
+
+  // Which nodes read a parameter, and where the subtree of each node starts; in postfix
+  // order a subtree is the run of nodes ending at its root
+  std::vector<bool> reads_parameter(m_nodes.size(), false);
+  std::vector<std::uint32_t> subtree_start(m_nodes.size(), 0);
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    subtree_start[i] = static_cast<std::uint32_t>(i);
+    if (node.op == Op::Variable) {
+      reads_parameter[i] = node.lhs >= leading;
+    } else if (node.op != Op::Constant) {
+      const bool unary = is_unary(node.op);
+      reads_parameter[i] = reads_parameter[node.lhs] || (!unary && reads_parameter[node.rhs]);
+      subtree_start[i] = subtree_start[node.lhs];
+    }
+  }
+
+  // Invariant roots: operations on the leading variables whose result a parameter-reading
+  // node consumes
+  std::vector<bool> invariant_root(m_nodes.size(), false);
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    if (node.op == Op::Constant || node.op == Op::Variable || !reads_parameter[i]) {
+      continue;
+    }
+    for (const std::uint32_t operand : {node.lhs, node.rhs}) {
+      const Op op = m_nodes[operand].op;
+      if ((operand == node.lhs || !is_unary(node.op)) && op != Op::Constant &&
+          op != Op::Variable && !reads_parameter[operand]) {
+        invariant_root[operand] = true;
+      }
+    }
+  }
+
+  // The invariants are copied out and their nodes replaced by one variable each
+  SplitTree split;
+  std::vector<bool> inside_invariant(m_nodes.size(), false);
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    if (!invariant_root[i]) {
+      continue;
+    }
+
+    ExpressionTree invariant;
+    invariant.m_variable_count = leading;
+    const std::uint32_t start = subtree_start[i];
+    for (std::size_t j = start; j <= i; ++j) {
+      Node node = m_nodes[j];
+      if (node.op != Op::Constant && node.op != Op::Variable) {
+        node.lhs -= start;
+        node.rhs = is_unary(node.op) ? 0 : node.rhs - start;
+      }
+      invariant.m_nodes.push_back(node);
+      inside_invariant[j] = j < i;
+    }
+    split.invariants.push_back(std::move(invariant));
+  }
+
+  ExpressionTree& residual = split.residual;
+  residual.m_variable_count = m_variable_count + split.invariants.size();
+  const auto invariant_count = static_cast<std::uint32_t>(split.invariants.size());
+  std::vector<std::uint32_t> moved(m_nodes.size(), 0);
+  std::uint32_t next_invariant = 0;
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    if (inside_invariant[i]) {
+      continue;
+    }
+
+    Node node = m_nodes[i];
+    if (invariant_root[i]) {
+      node = {Op::Variable, static_cast<std::uint32_t>(leading) + next_invariant++, 0, 0.0};
+    } else if (node.op == Op::Variable && node.lhs >= leading) {
+      node.lhs += invariant_count;
+    } else if (node.op != Op::Constant && node.op != Op::Variable) {
+      node.lhs = moved[node.lhs];
+      node.rhs = is_unary(node.op) ? 0 : moved[node.rhs];
+    }
+    residual.m_nodes.push_back(node);
+    moved[i] = static_cast<std::uint32_t>(residual.m_nodes.size() - 1);
+  }
+  return split;
+}
+
+bool ExpressionTree::is_constant(std::string_view name) {
+  const std::string lower = lowercase(name);
+  return std::any_of(CONSTANTS.begin(), CONSTANTS.end(), [&lower](const NamedConstant& named) {
+    return named.name == lower;
+  });
+}
+
+double ExpressionTree::apply(Op op, double a, double b) {
+  switch (op) {
+    case Op::Constant:
+    case Op::Variable:
+      return a;
+    case Op::Negate:
+      return -a;
+    case Op::Add:
+      return a + b;
+    case Op::Subtract:
+      return a - b;
+    case Op::Multiply:
+      return a * b;
+    case Op::Divide:
+      return a / b;
+    case Op::Modulo:
+      return std::fmod(a, b);
+    case Op::Power:
+      return std::pow(a, b);
+    case Op::Less:
+      return a < b ? 1.0 : 0.0;
+    case Op::LessEqual:
+      return a <= b ? 1.0 : 0.0;
+    case Op::Greater:
+      return a > b ? 1.0 : 0.0;
+    case Op::GreaterEqual:
+      return a >= b ? 1.0 : 0.0;
+    case Op::Equal:
+      return approximately_equal(a, b) ? 1.0 : 0.0;
+    case Op::NotEqual:
+      return approximately_equal(a, b) ? 0.0 : 1.0;
+    case Op::And:
+      return truthy(a) && truthy(b) ? 1.0 : 0.0;
+    case Op::Or:
+      return truthy(a) || truthy(b) ? 1.0 : 0.0;
+    case Op::Abs:
+      return std::abs(a);
+    case Op::Acos:
+      return std::acos(a);
+    case Op::Asin:
+      return std::asin(a);
+    case Op::Atan:
+      return std::atan(a);
+    case Op::Ceil:
+      return std::ceil(a);
+    case Op::Cos:
+      return std::cos(a);
+    case Op::Cosh:
+      return std::cosh(a);
+    case Op::Cot:
+      return 1.0 / std::tan(a);
+    case Op::Csc:
+      return 1.0 / std::sin(a);
+    case Op::Exp:
+      return std::exp(a);
+    case Op::Floor:
+      return std::floor(a);
+    case Op::Log:
+      return std::log(a);
+    case Op::Log10:
+      return std::log10(a);
+    case Op::Log2:
+      return std::log2(a);
+    case Op::Round:
+      return std::round(a);
+    case Op::Sec:
+      return 1.0 / std::cos(a);
+    case Op::Sgn:
+      return a > 0.0 ? 1.0 : (a < 0.0 ? -1.0 : 0.0);
+    case Op::Sin:
+      return std::sin(a);
+    case Op::Sinh:
+      return std::sinh(a);
+    case Op::Sqrt:
+      return std::sqrt(a);
+    case Op::Tan:
+      return std::tan(a);
+    case Op::Tanh:
+      return std::tanh(a);
+    case Op::Trunc:
+      return std::trunc(a);
+    case Op::Atan2:
+      return std::atan2(a, b);
+    case Op::Hypot:
+      return std::hypot(a, b);
+    case Op::Min:
+      return std::min(a, b);
+    case Op::Max:
+      return std::max(a, b);
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+Interval ExpressionTree::apply(Op op, const Interval& a, const Interval& b) {
+  const auto log_like = [&a](double (*f)(double)) {
+    if (a.hi <= 0.0) {
+      return Interval::entire();
+    }
+    return Interval{a.lo <= 0.0 ? -std::numeric_limits<double>::infinity() : f(a.lo), f(a.hi)};
+  };
+
+  switch (op) {
+    case Op::Constant:
+    case Op::Variable:
+      return a;
+    case Op::Negate:
+      return -a;
+    case Op::Add:
+      return a + b;
+    case Op::Subtract:
+      return a - b;
+    case Op::Multiply:
+      return a * b;
+    case Op::Divide:
+      return a / b;
+    case Op::Power:
+      return pow(a, b);
+    case Op::Less:
+      return boolean(a.hi >= b.lo, a.lo < b.hi);
+    case Op::LessEqual:
+      return boolean(a.hi > b.lo, a.lo <= b.hi);
+    case Op::Greater:
+      return boolean(a.lo <= b.hi, a.hi > b.lo);
+    case Op::GreaterEqual:
+      return boolean(a.lo < b.hi, a.hi >= b.lo);
+    case Op::And:
+      return boolean(a.contains(0.0) || b.contains(0.0),
+          (a.lo != 0.0 || a.hi != 0.0) && (b.lo != 0.0 || b.hi != 0.0));
+    case Op::Or:
+      return boolean(a.contains(0.0) && b.contains(0.0),
+          (a.lo != 0.0 || a.hi != 0.0) || (b.lo != 0.0 || b.hi != 0.0));
+    case Op::Abs:
+      return abs(a);
+    case Op::Atan:
+      return increasing(a, [](double v) { return std::atan(v); });
+    case Op::Ceil:
+      return increasing(a, [](double v) { return std::ceil(v); });
+    case Op::Cos:
+      return cos(a);
+    case Op::Cosh:
+      return increasing(abs(a), [](double v) { return std::cosh(v); });
+    case Op::Exp:
+      return increasing(a, [](double v) { return std::exp(v); });
+    case Op::Floor:
+      return increasing(a, [](double v) { return std::floor(v); });
+    case Op::Log:
+      return log_like([](double v) { return std::log(v); });
+    case Op::Log10:
+      return log_like([](double v) { return std::log10(v); });
+    case Op::Log2:
+      return log_like([](double v) { return std::log2(v); });
+    case Op::Round:
+      return increasing(a, [](double v) { return std::round(v); });
+    case Op::Sgn:
+      return increasing(a, [](double v) { return v > 0.0 ? 1.0 : (v < 0.0 ? -1.0 : 0.0); });
+    case Op::Sin:
+      return sin(a);
+    case Op::Sinh:
+      return increasing(a, [](double v) { return std::sinh(v); });
+    case Op::Sqrt:
+      if (a.hi < 0.0) {
+        return Interval::entire();
+      }
+      return {std::sqrt(std::max(0.0, a.lo)), std::sqrt(a.hi)};
+    case Op::Tan:
+      return tan(a);
+    case Op::Tanh:
+      return increasing(a, [](double v) { return std::tanh(v); });
+    case Op::Trunc:
+      return increasing(a, [](double v) { return std::trunc(v); });
+    case Op::Hypot:
+      return increasing(sqr(a) + sqr(b), [](double v) { return std::sqrt(v); });
+    case Op::Min:
+      return min(a, b);
+    case Op::Max:
+      return max(a, b);
+    default:
+      // Equality, modulo and the remaining trigonometric functions are not bounded
+      // tightly; they never prune anything.
+      return Interval::entire();
+  }
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Core/Plot/Interval.hpp"
+
+namespace App::Plot {
+
+struct SplitTree;
+
+enum class Op : std::uint8_t {
+  Constant,
+  Variable,
+
+  Negate,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Modulo,
+  Power,
+
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Equal,
+  NotEqual,
+  And,
+  Or,
+
+  Abs,
+  Acos,
+  Asin,
+  Atan,
+  Ceil,
+  Cos,
+  Cosh,
+  Cot,
+  Csc,
+  Exp,
+  Floor,
+  Log,
+  Log10,
+  Log2,
+  Round,
+  Sec,
+  Sgn,
+  Sin,
+  Sinh,
+  Sqrt,
+  Tan,
+  Tanh,
+  Trunc,
+
+  Atan2,
+  Hypot,
+  Min,
+  Max,
+};
+
+// One operation of an ExpressionTree. Operands always refer to nodes with a lower index.
+struct Node {
+  Op op{Op::Constant};
+  std::uint32_t lhs{0};  // first operand, or the variable index of a Variable node
+  std::uint32_t rhs{0};
+  double value{0.0};  // value of a Constant node
+};
+
+// A parsed form of the arithmetic subset of exprtk's syntax which the plot engines can
+// analyse themselves (exprtk's node tree is opaque). Nodes are stored in evaluation
+// order with the root last and constant sub-expressions already folded.
+//
+// Anything outside the subset (assignments, control flow, string and vector ops, ...)
+// makes `parse()` fail; exprtk stays the reference evaluator and callers are expected to
+// fall back to it in that case.
+class ExpressionTree {
+ public:
+  [[nodiscard]] static std::optional<ExpressionTree> parse(std::string_view text,
+      std::span<const std::string_view> variables);
+
+  [[nodiscard]] double evaluate(std::span<const double> variables,
+      std::vector<double>& scratch) const;
+  [[nodiscard]] Interval evaluate(std::span<const Interval> variables,
+      std::vector<Interval>& scratch) const;
+
+  [[nodiscard]] const std::vector<Node>& nodes() const {
+    return m_nodes;
+  }
+  [[nodiscard]] std::size_t variable_count() const {
+    return m_variable_count;
+  }
+  [[nodiscard]] bool uses_variable(std::uint32_t index) const;
+
+  // The tree with its last values.size() variables replaced by those values and folded
+  // again, so sub-expressions of only those variables cost nothing per evaluation.
+  [[nodiscard]] ExpressionTree bind(std::span<const double> values) const;
+
+  // Splits off the largest sub-expressions that read none of the last `parameter_count`
+  // variables, the parameters, but feed into one that does. See SplitTree.
+  [[nodiscard]] SplitTree split(std::size_t parameter_count) const;
+
+  // Whether `name` is one of the named constants expressions can use, e.g. pi.
+  [[nodiscard]] static bool is_constant(std::string_view name);
+
+  [[nodiscard]] static double apply(Op op, double a, double b);
+  [[nodiscard]] static Interval apply(Op op, const Interval& a, const Interval& b);
+
+ private:
+  std::vector<Node> m_nodes;
+  std::size_t m_variable_count{0};
+};
+
+// An expression in leading variables and parameters, split so the parts that read no
+// parameter can be evaluated once per point and reused while only the parameters change.
+// `invariants` are in the leading variables alone; `residual` reads the leading
+// variables, then one variable per invariant holding its value, then the parameters.
+struct SplitTree {
+  ExpressionTree residual;
+  std::vector<ExpressionTree> invariants;
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace App::Plot {
+
+// A closed range of doubles. All operations are conservative: whenever a tight bound is
+// not known (or the operation leaves its domain) the result is the entire real line,
+// which never causes a region containing part of the curve to be discarded.
+struct Interval {
+  double lo{0.0};
+  double hi{0.0};
+
+  [[nodiscard]] static Interval entire() {
+    return {-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+  }
+
+  [[nodiscard]] static Interval hull(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) {
+      return entire();
+    }
+    return {std::min(a, b), std::max(a, b)};
+  }
+
+  [[nodiscard]] bool contains(double value) const {
+    return lo <= value && value <= hi;
+  }
+};
+
+inline Interval operator-(const Interval& a) {
+  return {-a.hi, -a.lo};
+}
+
+inline Interval operator+(const Interval& a, const Interval& b) {
+  return Interval::hull(a.lo + b.lo, a.hi + b.hi);
+}
+
+inline Interval operator-(const Interval& a, const Interval& b) {
+  return Interval::hull(a.lo - b.hi, a.hi - b.lo);
+}
+
+inline Interval operator*(const Interval& a, const Interval& b) {
+  const double p0 = a.lo * b.lo;
+  const double p1 = a.lo * b.hi;
+  const double p2 = a.hi * b.lo;
+  const double p3 = a.hi * b.hi;
+  if (std::isnan(p0) || std::isnan(p1) || std::isnan(p2) || std::isnan(p3)) {
+    // 0 * inf
+    return Interval::entire();
+  }
+  return {std::min({p0, p1, p2, p3}), std::max({p0, p1, p2, p3})};
+}
+
+inline Interval operator/(const Interval& a, const Interval& b) {
+  if (b.contains(0.0)) {
+    return Interval::entire();
+  }
+  return a * Interval{1.0 / b.hi, 1.0 / b.lo};
+}
+
+// Applies a monotonically increasing function to both bounds.
+template <typename F>
+Interval increasing(const Interval& a, F f) {
+  return Interval::hull(f(a.lo), f(a.hi));
+}
+
+inline Interval abs(const Interval& a) {
+  if (a.lo >= 0.0) {
+    return a;
+  }
+  if (a.hi <= 0.0) {
+    return -a;
+  }
+  return {0.0, std::max(-a.lo, a.hi)};
+}
+
+inline Interval sqr(const Interval& a) {
+  const Interval m = abs(a);
+  return {m.lo * m.lo, m.hi * m.hi};
+}
+
+inline Interval pow(const Interval& base, const Interval& exponent) {
+  if (exponent.lo == exponent.hi && std::trunc(exponent.lo) == exponent.lo &&
+      std::abs(exponent.lo) <= 64.0) {
+    const double n = exponent.lo;
+    if (n == 0.0) {
+      return {1.0, 1.0};
+    }
+    if (n < 0.0) {
+      return Interval{1.0, 1.0} / pow(base, Interval{-n, -n});
+    }
+    if (std::fmod(n, 2.0) == 0.0) {
+      const Interval m = abs(base);
+      return {std::pow(m.lo, n), std::pow(m.hi, n)};
+    }
+    return increasing(base, [n](double v) { return std::pow(v, n); });
+  }
+  if (base.lo > 0.0) {
+    // b^e = exp(e * log(b))
+    const Interval log_base = increasing(base, [](double v) { return std::log(v); });
+    return increasing(exponent * log_base, [](double v) { return std::exp(v); });
+  }
+  return Interval::entire();
+}
+
+inline Interval sin(const Interval& a) {
+  constexpr double two_pi = 2.0 * std::numbers::pi;
+  if (!std::isfinite(a.lo) || !std::isfinite(a.hi) || a.hi - a.lo >= two_pi) {
+    return {-1.0, 1.0};
+  }
+  double lo = std::min(std::sin(a.lo), std::sin(a.hi));
+  double hi = std::max(std::sin(a.lo), std::sin(a.hi));
+  // Maxima at pi/2 + 2k*pi, minima at 3pi/2 + 2k*pi
+  if (std::ceil((a.lo - std::numbers::pi / 2.0) / two_pi) <=
+      (a.hi - std::numbers::pi / 2.0) / two_pi) {
+    hi = 1.0;
+  }
+  if (std::ceil((a.lo - 3.0 * std::numbers::pi / 2.0) / two_pi) <=
+      (a.hi - 3.0 * std::numbers::pi / 2.0) / two_pi) {
+    lo = -1.0;
+  }
+  return {lo, hi};
+}
+
+inline Interval cos(const Interval& a) {
+  return sin(a + Interval{std::numbers::pi / 2.0, std::numbers::pi / 2.0});
+}
+
+inline Interval tan(const Interval& a) {
+  if (!std::isfinite(a.lo) || !std::isfinite(a.hi) || a.hi - a.lo >= std::numbers::pi) {
+    return Interval::entire();
+  }
+  // Poles at pi/2 + k*pi
+  const double k_lo = std::floor((a.lo - std::numbers::pi / 2.0) / std::numbers::pi);
+  const double k_hi = std::floor((a.hi - std::numbers::pi / 2.0) / std::numbers::pi);
+  if (k_lo != k_hi) {
+    return Interval::entire();
+  }
+  return increasing(a, [](double v) { return std::tan(v); });
+}
+
+inline Interval min(const Interval& a, const Interval& b) {
+  return {std::min(a.lo, b.lo), std::min(a.hi, b.hi)};
+}
+
+inline Interval max(const Interval& a, const Interval& b) {
+  return {std::max(a.lo, b.lo), std::max(a.hi, b.hi)};
+}
+
+}  // namespace App::Plot
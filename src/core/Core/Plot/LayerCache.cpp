@@ -0,0 +1,127 @@
+#include "LayerCache.hpp"
+
+#include <SDL2/SDL.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <imgui.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Geometry blended into a cleared texture leaves premultiplied colors behind, which are
+// composited as such; plain alpha blending would darken antialiased edges
+SDL_BlendMode premultiplied_blend_mode() {
+  return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE,
+      SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+      SDL_BLENDOPERATION_ADD,
+      SDL_BLENDFACTOR_ONE,
+      SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+      SDL_BLENDOPERATION_ADD);
+}
+
+}  // namespace
+
+LayerCache::LayerCache(SDL_Renderer* renderer)
+    : m_renderer(renderer), m_supported(SDL_RenderTargetSupported(renderer) == SDL_TRUE) {}
+
+LayerCache::~LayerCache() {
+  reset();
+}
+
+void LayerCache::reset() {
+  if (m_texture != nullptr) {
+    SDL_DestroyTexture(m_texture);
+    m_texture = nullptr;
+  }
+  m_width = 0;
+  m_height = 0;
+  m_stale = true;
+}
+
+bool LayerCache::begin(const CanvasView& view, std::uint64_t revision) {
+  const ImVec2 size(view.max.x - view.min.x, view.max.y - view.min.y);
+  const ImVec2 origin(view.origin.x - view.min.x, view.origin.y - view.min.y);
+  const ImVec2 scale = ImGui::GetIO().DisplayFramebufferScale;
+  const int width = static_cast<int>(std::lround(size.x * scale.x));
+  const int height = static_cast<int>(std::lround(size.y * scale.y));
+  if (width <= 0 || height <= 0) {
+    m_stale = true;
+    return false;
+  }
+
+  if (!m_stale && width == m_width && height == m_height && origin.x == m_view.origin.x &&
+      origin.y == m_view.origin.y && view.zoom == m_view.zoom && revision == m_revision) {
+    return false;
+  }
+
+  if (m_texture == nullptr || width != m_width || height != m_height) {
+    reset();
+    m_texture = SDL_CreateTexture(
+        m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (m_texture == nullptr) {
+      // Drawn straight into the draw list from the next frame on
+      APP_ERROR("Error creating plot layer texture: {}", SDL_GetError());
+      m_supported = false;
+      return false;
+    }
+
+    if (SDL_SetTextureBlendMode(m_texture, premultiplied_blend_mode()) != 0) {
+      SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    }
+    // The texture covers the canvas pixel for pixel
+    SDL_SetTextureScaleMode(m_texture, SDL_ScaleModeNearest);
+    m_width = width;
+    m_height = height;
+  }
+
+  m_view = CanvasView{ImVec2(0.0F, 0.0F), size, origin, view.zoom};
+  m_scale = scale;
+  m_revision = revision;
+  m_stale = false;
+
+  m_draw_list._Data = ImGui::GetDrawListSharedData();
+  m_draw_list._ResetForNewFrame();
+  m_draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+  m_draw_list.PushClipRect(m_view.min, m_view.max);
+  return true;
+}
+
+void LayerCache::end() {
+  APP_PROFILE_FUNCTION();
+
+  m_draw_list._PopUnusedDrawCmd();
+
+  ImDrawData draw_data;
+  draw_data.Valid = true;
+  draw_data.DisplayPos = m_view.min;
+  draw_data.DisplaySize = m_view.max;
+  draw_data.FramebufferScale = m_scale;
+  draw_data.AddDrawList(&m_draw_list);
+
+  // Switching targets saves the window's viewport and scale and restores them afterwards
+  SDL_Texture* previous_target = SDL_GetRenderTarget(m_renderer);
+  SDL_SetRenderTarget(m_renderer, m_texture);
+  SDL_RenderSetScale(m_renderer, m_scale.x, m_scale.y);
+  SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+  SDL_RenderClear(m_renderer);
+  ImGui_ImplSDLRenderer2_RenderDrawData(&draw_data, m_renderer);
+  SDL_SetRenderTarget(m_renderer, previous_target);
+}
+
+void LayerCache::composite(ImDrawList* draw_list, const CanvasView& view) const {
+  if (m_texture == nullptr || m_stale) {
+    return;
+  }
+
+  draw_list->AddImage(static_cast<ImTextureID>(m_texture),
+      view.min,
+      ImVec2(view.min.x + m_view.max.x, view.min.y + m_view.max.y));
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <imgui.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace App::Plot {
+
+// Where the canvas is on the screen and how world coordinates map onto it.
+struct CanvasView {
+  ImVec2 min;
+  ImVec2 max;
+  // Screen position of the world origin
+  ImVec2 origin;
+  // Pixels per unit
+  float zoom{1.0F};
+};
+
+// One layer of the canvas, e.g. the axes or a plot, rendered into a texture the size of
+// the canvas and then drawn as a single quad. The layer's geometry is only issued and
+// rasterized again when the texture is stale: the canvas was resized, the view panned or
+// zoomed, or the layer's revision changed. While the view rests, a frame costs a quad per
+// layer however complex the plots are.
+//
+// Renderers without render targets get the layer drawn straight into the draw list
+// every frame instead.
+class LayerCache {
+ public:
+  explicit LayerCache(SDL_Renderer* renderer);
+  ~LayerCache();
+
+  LayerCache(const LayerCache&) = delete;
+  LayerCache(LayerCache&&) = delete;
+  LayerCache& operator=(LayerCache other) = delete;
+  LayerCache& operator=(LayerCache&& other) = delete;
+
+  // Draws the layer over the canvas of `view` into `draw_list`. `draw_layer` is called as
+  // draw_layer(ImDrawList*, const CanvasView&) to issue the layer's geometry when the
+  // texture is stale, with a view in the texture's coordinates: the canvas starts at (0, 0).
+  template <typename DrawLayer>
+  void draw(ImDrawList* draw_list,
+      const CanvasView& view,
+      std::uint64_t revision,
+      DrawLayer&& draw_layer) {
+    if (!m_supported) {
+      std::forward<DrawLayer>(draw_layer)(draw_list, view);
+      return;
+    }
+
+    if (begin(view, revision)) {
+      std::forward<DrawLayer>(draw_layer)(&m_draw_list, m_view);
+      end();
+    }
+    composite(draw_list, view);
+  }
+
+  // Forgets the texture, e.g. after the renderer lost its render targets.
+  void reset();
+
+ private:
+  // Whether the texture is stale; if so, prepares the draw list for the layer.
+  bool begin(const CanvasView& view, std::uint64_t revision);
+  // Rasterizes the draw list into the texture.
+  void end();
+  void composite(ImDrawList* draw_list, const CanvasView& view) const;
+
+  SDL_Renderer* m_renderer{nullptr};
+  bool m_supported{false};
+  SDL_Texture* m_texture{nullptr};
+  int m_width{0};
+  int m_height{0};
+
+  // What the texture shows
+  CanvasView m_view;
+  ImVec2 m_scale{1.0F, 1.0F};
+  std::uint64_t m_revision{0};
+  bool m_stale{true};
+
+  ImDrawList m_draw_list{nullptr};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,273 @@
+#include "MarchingSquares.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Edge ids: every node owns the edge to its right (even id) and the one above it (odd id).
+std::uint64_t horizontal_edge(std::uint64_t node) {
+  return 2 * node;
+}
+
+std::uint64_t vertical_edge(std::uint64_t node) {
+  return 2 * node + 1;
+}
+
+// Sparse lattices key their nodes by (row, column) instead of a dense index.
+std::uint64_t sparse_node(std::uint64_t column, std::uint64_t row) {
+  return (row << 31U) | column;
+}
+
+// Emits the segments of one cell with corner values v0 (bottom left), v1 (bottom right),
+// v2 (top right) and v3 (top left). Cells touching a non-finite value are skipped.
+template <typename AddSegment>
+void march_cell(double v0,
+    double v1,
+    double v2,
+    double v3,
+    std::uint64_t bottom_left_node,
+    std::uint64_t bottom_right_node,
+    std::uint64_t top_left_node,
+    AddSegment add_segment) {
+  if (!std::isfinite(v0) || !std::isfinite(v1) || !std::isfinite(v2) || !std::isfinite(v3)) {
+    return;
+  }
+
+  const int index =
+      (v0 > 0.0 ? 1 : 0) | (v1 > 0.0 ? 2 : 0) | (v2 > 0.0 ? 4 : 0) | (v3 > 0.0 ? 8 : 0);
+  if (index == 0 || index == 15) {
+    return;
+  }
+
+  const std::uint64_t bottom = horizontal_edge(bottom_left_node);
+  const std::uint64_t right = vertical_edge(bottom_right_node);
+  const std::uint64_t top = horizontal_edge(top_left_node);
+  const std::uint64_t left = vertical_edge(bottom_left_node);
+  // Saddles are resolved with the value at the cell center
+  const bool center_inside = (v0 + v1 + v2 + v3) > 0.0;
+
+  switch (index) {
+    case 1:
+    case 14:
+      add_segment(left, bottom);
+      break;
+    case 2:
+    case 13:
+      add_segment(bottom, right);
+      break;
+    case 3:
+    case 12:
+      add_segment(left, right);
+      break;
+    case 4:
+    case 11:
+      add_segment(right, top);
+      break;
+    case 6:
+    case 9:
+      add_segment(bottom, top);
+      break;
+    case 7:
+    case 8:
+      add_segment(left, top);
+      break;
+    case 5:
+      if (center_inside) {
+        add_segment(bottom, right);
+        add_segment(top, left);
+      } else {
+        add_segment(left, bottom);
+        add_segment(right, top);
+      }
+      break;
+    case 10:
+      if (center_inside) {
+        add_segment(left, bottom);
+        add_segment(right, top);
+      } else {
+        add_segment(bottom, right);
+        add_segment(top, left);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Position of the zero crossing between two nodes
+ImVec2 crossing(double x0, double y0, double v0, double v1, double step, bool vertical) {
+  const double t = std::clamp(v0 / (v0 - v1), 0.0, 1.0);
+  const double x = x0 + (vertical ? 0.0 : t * step);
+  const double y = y0 + (vertical ? t * step : 0.0);
+  return {static_cast<float>(x), static_cast<float>(y)};
+}
+
+void attach(std::array<std::int32_t, 2>& slots, std::int32_t segment) {
+  slots[slots[0] < 0 ? 0 : 1] = segment;
+}
+
+}  // namespace
+
+void ContourExtractor::extract(const ScalarGrid& grid, Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  out.clear();
+  m_segments.clear();
+  if (grid.columns < 2 || grid.rows < 2) {
+    return;
+  }
+  m_edge_segments.assign(2 * grid.columns * grid.rows, {NONE, NONE});
+
+  const auto add_segment = [this](std::uint64_t a, std::uint64_t b) {
+    const auto index = static_cast<std::int32_t>(m_segments.size());
+    m_segments.push_back({a, b});
+    attach(m_edge_segments[a], index);
+    attach(m_edge_segments[b], index);
+  };
+
+  for (std::size_t row = 0; row + 1 < grid.rows; ++row) {
+    for (std::size_t column = 0; column + 1 < grid.columns; ++column) {
+      const std::size_t node = row * grid.columns + column;
+      march_cell(grid.at(column, row),
+          grid.at(column + 1, row),
+          grid.at(column + 1, row + 1),
+          grid.at(column, row + 1),
+          node,
+          node + 1,
+          node + grid.columns,
+          add_segment);
+    }
+  }
+
+  link(
+      m_edge_segments,
+      [&grid](std::uint64_t edge) {
+        const std::uint64_t node = edge / 2;
+        const std::size_t column = node % grid.columns;
+        const std::size_t row = node / grid.columns;
+        const bool vertical = (edge % 2) == 1;
+        return crossing(grid.x(column),
+            grid.y(row),
+            grid.at(column, row),
+            vertical ? grid.at(column, row + 1) : grid.at(column + 1, row),
+            grid.step,
+            vertical);
+      },
+      out);
+}
+
+std::size_t ContourExtractor::extract(const SparseCells& cells,
+    const std::function<double(double, double)>& f,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  out.clear();
+  m_segments.clear();
+  m_sparse_edge_segments.clear();
+  m_node_values.clear();
+
+  std::size_t evaluations = 0;
+  const auto value = [&](std::uint64_t column, std::uint64_t row) {
+    const auto [it, inserted] = m_node_values.try_emplace(sparse_node(column, row), 0.0);
+    if (inserted) {
+      ++evaluations;
+      it->second = f(cells.x_min + static_cast<double>(column) * cells.step,
+          cells.y_min + static_cast<double>(row) * cells.step);
+    }
+    return it->second;
+  };
+
+  const auto add_segment = [this](std::uint64_t a, std::uint64_t b) {
+    const auto index = static_cast<std::int32_t>(m_segments.size());
+    m_segments.push_back({a, b});
+    attach(m_sparse_edge_segments.try_emplace(a, std::array{NONE, NONE}).first->second, index);
+    attach(m_sparse_edge_segments.try_emplace(b, std::array{NONE, NONE}).first->second, index);
+  };
+
+  for (const auto& [column, row] : cells.cells) {
+    march_cell(value(column, row),
+        value(column + 1, row),
+        value(column + 1, row + 1),
+        value(column, row + 1),
+        sparse_node(column, row),
+        sparse_node(column + 1, row),
+        sparse_node(column, row + 1),
+        add_segment);
+  }
+
+  link(
+      m_sparse_edge_segments,
+      [this, &cells](std::uint64_t edge) {
+        const std::uint64_t node = edge / 2;
+        const std::uint64_t column = node & ((1ULL << 31U) - 1);
+        const std::uint64_t row = node >> 31U;
+        const bool vertical = (edge % 2) == 1;
+        const std::uint64_t next =
+            vertical ? sparse_node(column, row + 1) : sparse_node(column + 1, row);
+        return crossing(cells.x_min + static_cast<double>(column) * cells.step,
+            cells.y_min + static_cast<double>(row) * cells.step,
+            m_node_values.at(node),
+            m_node_values.at(next),
+            cells.step,
+            vertical);
+      },
+      out);
+
+  return evaluations;
+}
+
+// Links the segments through their shared edges. Each chain is walked backwards from
+// its first segment, then forwards; closed loops are consumed entirely by the backward
+// walk and end on their starting point.
+template <typename Slots, typename Emit>
+void ContourExtractor::link(Slots& slots, Emit emit, Polylines& out) {
+  const auto next_segment = [&slots](std::uint64_t edge, std::int32_t from) {
+    const std::array<std::int32_t, 2>& pair = slots[edge];
+    return pair[0] == from ? pair[1] : pair[0];
+  };
+
+  m_visited.assign(m_segments.size(), false);
+  for (std::size_t first = 0; first < m_segments.size(); ++first) {
+    if (m_visited[first]) {
+      continue;
+    }
+    m_visited[first] = true;
+
+    const auto first_index = static_cast<std::int32_t>(first);
+    const auto walk = [&](std::uint64_t edge, auto on_edge) {
+      std::int32_t current = first_index;
+      for (std::int32_t next = next_segment(edge, current);
+           next != NONE && !m_visited[static_cast<std::size_t>(next)];
+           next = next_segment(edge, current)) {
+        const Segment& segment = m_segments[static_cast<std::size_t>(next)];
+        m_visited[static_cast<std::size_t>(next)] = true;
+        edge = segment.a == edge ? segment.b : segment.a;
+        on_edge(edge);
+        current = next;
+      }
+    };
+
+    m_backward.clear();
+    walk(m_segments[first].a, [this](std::uint64_t edge) { m_backward.push_back(edge); });
+
+    for (auto it = m_backward.rbegin(); it != m_backward.rend(); ++it) {
+      out.add_point(emit(*it));
+    }
+    out.add_point(emit(m_segments[first].a));
+    out.add_point(emit(m_segments[first].b));
+    walk(m_segments[first].b, [&](std::uint64_t edge) { out.add_point(emit(edge)); });
+
+    out.end_strip();
+  }
+}
+
+}  // namespace App::Plot
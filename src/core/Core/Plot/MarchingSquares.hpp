@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+// Function values sampled on the nodes of a regular grid, stored row by row from
+// the bottom (y_min) row upwards.
+struct ScalarGrid {
+  double x_min{0.0};
+  double y_min{0.0};
+  double step{1.0};
+  std::size_t columns{0};
+  std::size_t rows{0};
+  std::vector<double> values;
+
+  void resize(std::size_t column_count, std::size_t row_count) {
+    columns = column_count;
+    rows = row_count;
+    values.resize(columns * rows);
+  }
+
+  [[nodiscard]] double x(std::size_t column) const {
+    return x_min + static_cast<double>(column) * step;
+  }
+  [[nodiscard]] double y(std::size_t row) const {
+    return y_min + static_cast<double>(row) * step;
+  }
+  [[nodiscard]] double at(std::size_t column, std::size_t row) const {
+    return values[row * columns + column];
+  }
+};
+
+// A subset of the cells of a regular lattice, e.g. the leaves of a quadtree. Cell
+// (column, row) spans [x_min + column * step, x_min + (column + 1) * step] horizontally.
+struct SparseCells {
+  double x_min{0.0};
+  double y_min{0.0};
+  double step{1.0};
+  std::vector<std::array<std::uint32_t, 2>> cells;
+};
+
+// Extracts the zero level set of sampled functions with marching squares. The segments
+// of neighbouring cells share the crossing point of their common edge, which is used
+// to link them into connected polylines instead of a soup of separate segments.
+// Scratch buffers are kept between calls.
+class ContourExtractor {
+ public:
+  void extract(const ScalarGrid& grid, Polylines& out);
+
+  // Marches only the given cells, evaluating each lattice node they touch once.
+  // Returns the number of evaluations of `f`.
+  std::size_t extract(const SparseCells& cells,
+      const std::function<double(double, double)>& f,
+      Polylines& out);
+
+ private:
+  static constexpr std::int32_t NONE{-1};
+
+  struct Segment {
+    std::uint64_t a;
+    std::uint64_t b;
+  };
+
+  template <typename Slots, typename Emit>
+  void link(Slots& slots, Emit emit, Polylines& out);
+
+  std::vector<Segment> m_segments;
+  // Two segment slots per grid edge, every crossing is shared by at most two cells
+  std::vector<std::array<std::int32_t, 2>> m_edge_segments;
+  std::unordered_map<std::uint64_t, std::array<std::int32_t, 2>> m_sparse_edge_segments;
+  std::unordered_map<std::uint64_t, double> m_node_values;
+  std::vector<bool> m_visited;
+  std::vector<std::uint64_t> m_backward;
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,226 @@
+#include "PlotDescription.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/Tokenizer.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// exprtk's operator words and control flow, which read no variable
+constexpr std::array<std::string_view, 25> KEYWORDS{"and", "break", "case", "continue",
+    "default", "else", "false", "for", "if", "ilike", "in", "like", "mand", "mor", "nand", "nor",
+    "not", "null", "or", "repeat", "return", "switch", "true", "until", "var"};
+
+bool is_symbol(const Token& token, std::string_view symbol) {
+  return token.kind == TokenKind::Symbol && token.text == symbol;
+}
+
+bool opens(const Token& token) {
+  return is_symbol(token, "(") || is_symbol(token, "[") || is_symbol(token, "{");
+}
+
+bool closes(const Token& token) {
+  return is_symbol(token, ")") || is_symbol(token, "]") || is_symbol(token, "}");
+}
+
+bool is_relation(const Token& token) {
+  return is_symbol(token, "<") || is_symbol(token, ">") || is_symbol(token, "<=") ||
+         is_symbol(token, ">=") || is_symbol(token, "!=") || is_symbol(token, "<>");
+}
+
+std::string_view trim(std::string_view text) {
+  const auto blank = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+  while (!text.empty() && blank(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && blank(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+std::string lowercase(std::string_view text) {
+  std::string result{text};
+  std::transform(result.begin(), result.end(), result.begin(), [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return result;
+}
+
+// Adds the variables read by `tokens` to `out`: identifiers that are not called as
+// functions, constants or keywords.
+void collect_free_variables(std::span<const Token> tokens, std::vector<std::string>& out) {
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    if (tokens[i].kind != TokenKind::Identifier) {
+      continue;
+    }
+    if (i + 1 < tokens.size() && is_symbol(tokens[i + 1], "(")) {
+      continue;
+    }
+    std::string name = lowercase(tokens[i].text);
+    if (std::find(KEYWORDS.begin(), KEYWORDS.end(), name) != KEYWORDS.end() ||
+        ExpressionTree::is_constant(name)) {
+      continue;
+    }
+    out.push_back(std::move(name));
+  }
+}
+
+bool reads(const std::vector<std::string>& variables, std::string_view name) {
+  return std::find(variables.begin(), variables.end(), name) != variables.end();
+}
+
+void sort_unique(std::vector<std::string>& names) {
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+}
+
+// Fills in the parameters once the mode is known: the free variables of the compiled
+// parts that are not the mode's own
+void add_parameters(PlotDescription& description,
+    const std::vector<std::string>& part_variables) {
+  const std::span<const std::string_view> own = mode_variables(description.mode);
+  for (const std::string& name : part_variables) {
+    if (std::find(own.begin(), own.end(), name) == own.end()) {
+      description.parameters.push_back(name);
+    }
+  }
+}
+
+}  // namespace
+
+std::span<const std::string_view> mode_variables(PlotMode mode) {
+  static constexpr std::array<std::string_view, 2> xy{"x", "y"};
+  static constexpr std::array<std::string_view, 1> t{"t"};
+  static constexpr std::array<std::string_view, 1> theta{"theta"};
+  switch (mode) {
+    case PlotMode::Parametric:
+      return t;
+    case PlotMode::Inequality:
+    case PlotMode::Implicit:
+      return xy;
+    case PlotMode::Polar:
+      return theta;
+    case PlotMode::Explicit:
+      return std::span(xy).first(1);
+    case PlotMode::None:
+      break;
+  }
+  return {};
+}
+
+PlotDescription describe_plot(std::string_view text) {
+  std::vector<Token> tokens;
+  Tokenizer tokenizer{text};
+  for (Token token = tokenizer.next(); token.kind != TokenKind::End; token = tokenizer.next()) {
+    tokens.push_back(token);
+  }
+
+  PlotDescription description;
+  if (tokens.empty()) {
+    return description;
+  }
+  collect_free_variables(tokens, description.free_variables);
+  sort_unique(description.free_variables);
+
+  // The top-level structure: where the group opened by the first token closes, the first
+  // comma directly inside it and the first relation and equals signs outside any brackets
+  std::size_t group_end = tokens.size();
+  std::size_t comma = tokens.size();
+  std::size_t double_equals = tokens.size();
+  std::size_t equals = tokens.size();
+  bool has_relation = false;
+  int depth = 0;
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    const Token& token = tokens[i];
+    if (opens(token)) {
+      ++depth;
+    } else if (closes(token)) {
+      --depth;
+      if (depth == 0 && group_end == tokens.size()) {
+        group_end = i;
+      }
+    } else if (depth == 1 && group_end == tokens.size() && is_symbol(token, ",")) {
+      comma = std::min(comma, i);
+    } else if (depth == 0 && is_relation(token)) {
+      has_relation = true;
+    } else if (depth == 0 && is_symbol(token, "==")) {
+      double_equals = std::min(double_equals, i);
+    } else if (depth == 0 && is_symbol(token, "=")) {
+      // Not the assignment ":="
+      const bool assignment = i > 0 && tokens[i - 1].kind == TokenKind::Invalid &&
+                              tokens[i - 1].text == ":" &&
+                              tokens[i - 1].offset + 1 == token.offset;
+      if (!assignment) {
+        equals = std::min(equals, i);
+      }
+    }
+  }
+
+  // The text between two tokens, without them
+  const auto between = [&text](const Token& first, const Token& last) {
+    const std::size_t begin = first.offset + first.text.size();
+    return std::string{trim(text.substr(begin, last.offset - begin))};
+  };
+  const Token start{TokenKind::End, text.substr(0, 0), 0.0, 0};
+  const Token end{TokenKind::End, {}, 0.0, text.size()};
+
+  if (is_symbol(tokens.front(), "(") && group_end == tokens.size() - 1 &&
+      comma < tokens.size()) {
+    description.mode = PlotMode::Parametric;
+    description.primary = between(tokens.front(), tokens[comma]);
+    description.secondary = between(tokens[comma], tokens.back());
+    add_parameters(description, description.free_variables);
+    return description;
+  }
+
+  if (has_relation) {
+    description.mode = PlotMode::Inequality;
+    description.primary = between(start, end);
+    add_parameters(description, description.free_variables);
+    return description;
+  }
+
+  const std::size_t split = double_equals < tokens.size() ? double_equals : equals;
+  if (split < tokens.size()) {
+    const std::string lhs = between(start, tokens[split]);
+    const std::string rhs = between(tokens[split], end);
+
+    // "r = f(theta)"; the other sides of an implicit equation are in x and y
+    std::vector<std::string> rhs_variables;
+    collect_free_variables(std::span(tokens).subspan(split + 1), rhs_variables);
+    if (split == 1 && tokens.front().kind == TokenKind::Identifier &&
+        lowercase(tokens.front().text) == "r" && !reads(rhs_variables, "x") &&
+        !reads(rhs_variables, "y")) {
+      description.mode = PlotMode::Polar;
+      // r itself is what the curve gives, not a parameter
+      description.primary = rhs;
+      sort_unique(rhs_variables);
+      add_parameters(description, rhs_variables);
+      return description;
+    }
+
+    description.mode = PlotMode::Implicit;
+    description.primary = "(" + lhs + ") - (" + rhs + ")";
+    add_parameters(description, description.free_variables);
+    return description;
+  }
+
+  description.mode = PlotMode::Explicit;
+  description.primary = between(start, end);
+  add_parameters(description, description.free_variables);
+  return description;
+}
+
+}  // namespace App::Plot
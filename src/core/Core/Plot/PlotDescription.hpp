@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace App::Plot {
+
+enum class PlotMode : std::uint8_t { None, Parametric, Inequality, Implicit, Polar, Explicit };
+
+// The value a parameter has until it is set.
+constexpr double default_parameter_value = 1.0;
+
+// What an expression text asks to plot, worked out from a single pass over its tokens.
+// Operators only count outside brackets, so "(x > 0)" is an explicit function:
+//   (f(t), g(t))                  Parametric
+//   a <, <=, >, >=, != or <>      Inequality, the region where it holds
+//   r = f(theta)                  Polar
+//   lhs = rhs, lhs == rhs         Implicit, e.g. y = x^2 or x^2 + y^2 = 1
+//   anything else                 Explicit, y = f(x)
+struct PlotDescription {
+  PlotMode mode{PlotMode::None};
+  // f(x), r(theta), x(t), the inequality or lhs - rhs of an implicit equation
+  std::string primary;
+  // y(t) of a parametric curve, empty for the other modes
+  std::string secondary;
+  // Lowercase names the text reads that are neither functions, constants nor keywords,
+  // sorted: the mode's own variables plus any unknowns
+  std::vector<std::string> free_variables;
+  // The free variables that are not the mode's own, e.g. a and b in y = a*sin(b*x). They
+  // are bound to values set from outside, in this order.
+  std::vector<std::string> parameters;
+};
+
+// The variables a plot of `mode` is in: x and y, x, t or theta.
+[[nodiscard]] std::span<const std::string_view> mode_variables(PlotMode mode);
+
+// Text that is only blanks describes nothing. The description is not checked any further:
+// its parts may still fail to compile.
+[[nodiscard]] PlotDescription describe_plot(std::string_view text);
+
+}  // namespace App::Plot
@@ -0,0 +1,261 @@
+#include "PlotEvaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/FrameStats.hpp"
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/ExpressionCache.hpp"
+#include "Core/ThreadPool.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// Full-detail passes slower than this are preceded by a coarse preview
+constexpr auto frame_budget = std::chrono::milliseconds(16);
+constexpr double preview_coarseness = 4.0;
+
+}  // namespace
+
+struct PlotEvaluator::Layer {
+  explicit Layer(ThreadPool& thread_pool) : sampler(thread_pool) {}
+
+  // Guarded by m_mutex
+  std::string text;
+  std::vector<double> parameters;
+  PlotView view{};
+  // Bumped with every new request; jobs started under an older value are cancelled
+  std::atomic<std::uint64_t> generation{0};
+  std::uint64_t started_generation{0};
+  std::uint64_t completed_generation{0};
+  PlotResult ready;
+  bool has_ready{false};
+
+  // Only touched by the evaluation thread
+  ExpressionCache expressions;
+  PlotSampler sampler;
+  PlotResult back;
+  bool sampled{false};
+  std::uint64_t sampled_revision{0};
+  PlotView sampled_view{};
+  std::chrono::steady_clock::duration full_pass_time{};
+};
+
+PlotEvaluator::PlotEvaluator(std::function<void()> on_result)
+    : m_on_result(std::move(on_result)),
+      m_thread_pool(std::make_unique<ThreadPool>()),
+      m_thread([this] { run(); }) {}
+
+PlotEvaluator::~PlotEvaluator() {
+  {
+    const std::lock_guard lock(m_mutex);
+    m_stopping = true;
+    // Cancels the job in flight
+    for (const auto& [id, layer] : m_layers) {
+      layer->generation.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+void PlotEvaluator::submit(LayerId layer,
+    std::string_view text,
+    std::span<const double> parameters,
+    const PlotView& view) {
+  {
+    const std::lock_guard lock(m_mutex);
+    std::shared_ptr<Layer>& entry = m_layers[layer];
+    if (entry == nullptr) {
+      entry = std::make_shared<Layer>(*m_thread_pool);
+    } else if (text == entry->text && view == entry->view &&
+               std::equal(parameters.begin(),
+                   parameters.end(),
+                   entry->parameters.begin(),
+                   entry->parameters.end())) {
+      return;
+    }
+
+    // Both reuse their capacity
+    entry->text.assign(text);
+    entry->parameters.assign(parameters.begin(), parameters.end());
+    entry->view = view;
+    entry->generation.fetch_add(1, std::memory_order_relaxed);
+    ++m_requests;
+  }
+  m_wake.notify_one();
+}
+
+void PlotEvaluator::remove(LayerId layer) {
+  const std::lock_guard lock(m_mutex);
+  const auto entry = m_layers.find(layer);
+  if (entry == m_layers.end()) {
+    return;
+  }
+
+  // The evaluation thread keeps its own reference until the cancelled job returns
+  entry->second->generation.fetch_add(1, std::memory_order_relaxed);
+  m_layers.erase(entry);
+}
+
+void PlotEvaluator::set_tile_cache_capacity(std::size_t bytes) {
+  m_tile_cache_capacity.store(bytes, std::memory_order_relaxed);
+}
+
+bool PlotEvaluator::take(LayerId layer, PlotResult& result) {
+  const std::lock_guard lock(m_mutex);
+  const auto entry = m_layers.find(layer);
+  if (entry == m_layers.end() || !entry->second->has_ready) {
+    return false;
+  }
+
+  std::swap(result, entry->second->ready);
+  entry->second->has_ready = false;
+  return true;
+}
+
+bool PlotEvaluator::busy() const {
+  const std::lock_guard lock(m_mutex);
+  return std::any_of(m_layers.begin(), m_layers.end(), [](const auto& entry) {
+    const Layer& layer = *entry.second;
+    return layer.completed_generation != layer.generation.load(std::memory_order_relaxed);
+  });
+}
+
+void PlotEvaluator::run() {
+  std::uint64_t seen_requests = 0;
+  LayerId last_evaluated = 0;
+  bool evaluated_any = false;
+  // Copies of the request, reusing their capacity from job to job
+  std::string text;
+  std::vector<double> parameters;
+
+  while (true) {
+    std::shared_ptr<Layer> layer;
+    std::uint64_t job = 0;
+    PlotView view;
+    {
+      std::unique_lock lock(m_mutex);
+      m_wake.wait(lock, [this, seen_requests] {
+        return m_stopping || m_requests != seen_requests;
+      });
+      if (m_stopping) {
+        return;
+      }
+
+      // The next layer after the last evaluated one, wrapping around, with a request that
+      // was not started yet, so a layer resubmitted every frame cannot starve the others.
+      // Once there is none, the thread sleeps until the next request.
+      const auto is_pending = [](const auto& entry) {
+        const Layer& candidate = *entry.second;
+        return candidate.generation.load(std::memory_order_relaxed) !=
+               candidate.started_generation;
+      };
+      const auto next = evaluated_any ? m_layers.upper_bound(last_evaluated) : m_layers.begin();
+      auto pending = std::find_if(next, m_layers.end(), is_pending);
+      if (pending == m_layers.end()) {
+        pending = std::find_if(m_layers.begin(), next, is_pending);
+        if (pending == next) {
+          seen_requests = m_requests;
+          continue;
+        }
+      }
+
+      last_evaluated = pending->first;
+      evaluated_any = true;
+      layer = pending->second;
+      job = layer->generation.load(std::memory_order_relaxed);
+      layer->started_generation = job;
+      text.assign(layer->text);
+      parameters.assign(layer->parameters.begin(), layer->parameters.end());
+      view = layer->view;
+    }
+
+    evaluate(*layer, job, text, parameters, view);
+  }
+}
+
+void PlotEvaluator::evaluate(Layer& layer,
+    std::uint64_t job,
+    const std::string& text,
+    const std::vector<double>& parameters,
+    const PlotView& view) {
+  APP_PROFILE_SCOPE("PlotEvaluator::job");
+
+  // Hidden layers are removed, so the cap is only shared by the layers still shown
+  std::size_t layer_count = 1;
+  {
+    const std::lock_guard lock(m_mutex);
+    layer_count = std::max<std::size_t>(m_layers.size(), 1);
+  }
+  layer.sampler.set_tile_cache_capacity(
+      m_tile_cache_capacity.load(std::memory_order_relaxed) / layer_count);
+
+  layer.expressions.get(text);
+  layer.expressions.set_parameters(parameters);
+  const std::uint64_t revision = layer.expressions.revision();
+  const bool view_dependent = PlotSampler::is_view_dependent(layer.expressions.current().mode);
+  const bool stale = !layer.sampled || revision != layer.sampled_revision ||
+                     (view_dependent && !(view == layer.sampled_view));
+
+  if (stale) {
+    const CancelToken cancel(layer.generation, job);
+
+    const bool preview = view_dependent && layer.full_pass_time > frame_budget;
+    if (preview) {
+      if (!sample(layer, view, preview_coarseness, cancel)) {
+        return;
+      }
+      publish(layer);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!sample(layer, view, 1.0, cancel)) {
+      return;
+    }
+    layer.full_pass_time = std::chrono::steady_clock::now() - start;
+
+    layer.sampled = true;
+    layer.sampled_revision = revision;
+    layer.sampled_view = view;
+    publish(layer);
+  }
+
+  const std::lock_guard lock(m_mutex);
+  layer.completed_generation = job;
+}
+
+bool PlotEvaluator::sample(Layer& layer,
+    const PlotView& view,
+    double coarseness,
+    const CancelToken& cancel) {
+  const bool complete =
+      layer.sampler.sample(layer.expressions, view, coarseness, cancel, layer.back);
+  Debug::FrameStats::get().add_evaluations(layer.sampler.evaluations());
+  return complete;
+}
+
+void PlotEvaluator::publish(Layer& layer) {
+  {
+    const std::lock_guard lock(m_mutex);
+    std::swap(layer.back, layer.ready);
+    layer.has_ready = true;
+  }
+
+  if (m_on_result) {
+    m_on_result();
+  }
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Core/Plot/PlotSampler.hpp"
+
+namespace App {
+class ThreadPool;
+}  // namespace App
+
+namespace App::Plot {
+
+// Identifies one expression of the layer list for as long as it exists.
+using LayerId = std::uint64_t;
+
+// Compiles and samples plots on a background thread so a slow expression never stalls the
+// UI. Every layer has its own expression text, compiled form and tile cache; the UI
+// submits the text and view of each visible layer every frame, and a change cancels that
+// layer's job in flight and queues a new one. Completed results are handed over by
+// swapping buffers, so the UI keeps drawing a layer's previous result until the next one
+// is ready.
+//
+// Layers are evaluated one after another, taking turns in id order, each spreading its
+// grid work over the shared thread pool. Only layers whose text, parameter values or view
+// changed are evaluated again, and moving a parameter only costs the layers that read it.
+// A hidden layer is removed, so it holds neither tiles nor results.
+//
+// Sampling is progressive: when the last full-detail pass of a view-dependent plot took
+// longer than a frame, a coarse preview is published first. While the user drags the zoom
+// slider every step is then answered within about a frame, and the full-detail pass only
+// completes once the view stops changing.
+class PlotEvaluator {
+ public:
+  // `on_result` is called from the evaluation thread whenever a result becomes ready, so
+  // an idle UI can be woken up to take it.
+  explicit PlotEvaluator(std::function<void()> on_result = {});
+  ~PlotEvaluator();
+
+  PlotEvaluator(const PlotEvaluator&) = delete;
+  PlotEvaluator(PlotEvaluator&&) = delete;
+  PlotEvaluator& operator=(PlotEvaluator other) = delete;
+  PlotEvaluator& operator=(PlotEvaluator&& other) = delete;
+
+  // Cheap when neither the text, the parameters nor the view changed since the layer's
+  // last call: nothing is copied or allocated then. `parameters` are the values of
+  // describe_plot(text).parameters, in order. The first call adds the layer.
+  void submit(LayerId layer,
+      std::string_view text,
+      std::span<const double> parameters,
+      const PlotView& view);
+  // Cancels the layer's job and forgets everything about it, freeing its tiles and
+  // results, e.g. when the layer is hidden.
+  void remove(LayerId layer);
+
+  // Swaps the layer's latest completed result into `result`. Returns false, leaving
+  // `result` untouched, when nothing was completed since the last call.
+  bool take(LayerId layer, PlotResult& result);
+
+  // Whether a submitted request has not produced a result yet.
+  [[nodiscard]] bool busy() const;
+
+  // Memory cap of the sampled tiles of all layers together, shared evenly by the layers
+  // submitted and not removed since, applied from the next request on.
+  void set_tile_cache_capacity(std::size_t bytes);
+
+ private:
+  struct Layer;
+
+  void run();
+  // Samples into the layer's back buffer, counting the evaluations for the performance
+  // panel.
+  bool sample(Layer& layer, const PlotView& view, double coarseness, const CancelToken& cancel);
+  void evaluate(Layer& layer,
+      std::uint64_t job,
+      const std::string& text,
+      const std::vector<double>& parameters,
+      const PlotView& view);
+  void publish(Layer& layer);
+
+  std::function<void()> m_on_result;
+  std::unique_ptr<ThreadPool> m_thread_pool;
+
+  // Guards the requests and completed results of the layers, and the layer list
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  // Ordered by id, which is the order layers take turns in
+  std::map<LayerId, std::shared_ptr<Layer>> m_layers;
+  // Bumped with every new request, so the evaluation thread looks for work again
+  std::uint64_t m_requests{0};
+  bool m_stopping{false};
+  std::atomic<std::size_t> m_tile_cache_capacity{TileCache::default_capacity};
+
+  std::thread m_thread;
+};
+
+}  // namespace App::Plot
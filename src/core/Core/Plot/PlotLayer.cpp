@@ -0,0 +1,86 @@
+#include "PlotLayer.hpp"
+
+#include <imgui.h>
+
+#include <optional>
+#include <utility>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/PlotEvaluator.hpp"
+
+namespace App::Plot {
+
+PlotLayer::PlotLayer(SDL_Renderer* renderer) : m_region_texture(renderer) {}
+
+bool PlotLayer::update(PlotEvaluator& evaluator, LayerId layer) {
+  if (!evaluator.take(layer, m_result)) {
+    return false;
+  }
+
+  m_region_dirty = m_result.has_region;
+  ++m_revision;
+  return true;
+}
+
+void PlotLayer::update(PlotResult&& result) {
+  m_result = std::move(result);
+  m_region_dirty = m_result.has_region;
+  ++m_revision;
+}
+
+void PlotLayer::set_color(std::optional<ImU32> color) {
+  if (color != m_color) {
+    m_color = color;
+    ++m_revision;
+  }
+}
+
+void PlotLayer::on_render_reset() {
+  m_region_texture.reset();
+  m_region_dirty = m_result.has_region;
+}
+
+void PlotLayer::draw(ImDrawList* draw_list,
+    const ImVec2& origin,
+    float zoom,
+    float thickness,
+    FrameArena& scratch) {
+  APP_PROFILE_FUNCTION();
+
+  const ImU32 color = m_color.value_or(m_result.color);
+
+  const RegionMask& region = m_result.region;
+  if (m_result.has_region) {
+    if (m_region_dirty) {
+      m_region_texture.upload(
+          static_cast<int>(region.columns), static_cast<int>(region.rows), region.pixels.data());
+      m_region_dirty = false;
+    }
+
+    if (m_region_texture.valid()) {
+      const ImVec2 top_left(origin.x + static_cast<float>(region.x_min) * zoom,
+          origin.y - static_cast<float>(region.y_max()) * zoom);
+      const ImVec2 bottom_right(origin.x + static_cast<float>(region.x_max()) * zoom,
+          origin.y - static_cast<float>(region.y_min) * zoom);
+      draw_list->AddImage(m_region_texture.id(),
+          top_left,
+          bottom_right,
+          ImVec2(0.0F, 0.0F),
+          ImVec2(1.0F, 1.0F),
+          color);
+    }
+  }
+
+  draw_world_polylines(draw_list,
+      m_result.samples,
+      origin,
+      zoom,
+      color,
+      thickness,
+      m_result.x_monotonic,
+      m_decimator,
+      scratch);
+}
+
+}  // namespace App::Plot
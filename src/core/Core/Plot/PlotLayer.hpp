@@ -0,0 +1,61 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Decimation.hpp"
+#include "Core/Plot/PlotEvaluator.hpp"
+#include "Core/Plot/PlotSampler.hpp"
+#include "Core/Plot/Texture.hpp"
+
+namespace App::Plot {
+
+// Retained world-space polylines of an explicit, polar, parametric or implicit curve, or
+// the rasterized region of an inequality, as last completed by the PlotEvaluator. Every
+// frame just maps the stored polylines to the screen or draws the region texture as a
+// single quad; nothing is evaluated on the UI thread.
+//
+// Curves are sampled finer than a pixel where they bend, so the mapped strips are
+// decimated in screen space before they reach the draw list: graphs of y = f(x) per
+// pixel column, every other curve with Douglas-Peucker.
+class PlotLayer {
+ public:
+  explicit PlotLayer(SDL_Renderer* renderer);
+
+  // Picks up a newly completed result of `layer`, if any. Returns whether there was one.
+  bool update(PlotEvaluator& evaluator, LayerId layer);
+  // Shows `result`, e.g. one sampled synchronously without an evaluator.
+  void update(PlotResult&& result);
+  // Strip scratch is taken from `scratch`.
+  void draw(ImDrawList* draw_list,
+      const ImVec2& origin,
+      float zoom,
+      float thickness,
+      FrameArena& scratch);
+
+  // Draws curves and regions in `color` rather than the color of their mode.
+  void set_color(std::optional<ImU32> color);
+
+  // Uploads the region texture again on the next draw, after the renderer lost it.
+  void on_render_reset();
+
+  // Changes whenever a new result is shown.
+  [[nodiscard]] std::uint64_t revision() const {
+    return m_revision;
+  }
+
+ private:
+  PlotResult m_result;
+  std::uint64_t m_revision{0};
+  std::optional<ImU32> m_color;
+  PolylineDecimator m_decimator;
+
+  Texture m_region_texture;
+  bool m_region_dirty{false};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,603 @@
+#include "PlotSampler.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/FrameStats.hpp"
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/AdaptiveSampler.hpp"
+#include "Core/Plot/BatchProgram.hpp"
+#include "Core/Plot/ExpressionCache.hpp"
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/TileCache.hpp"
+#include "Core/ThreadPool.hpp"
+#include "exprtk.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+constexpr std::size_t grid_band_rows = 16;
+// Missing grid and region tiles are evaluated in batches of enough bands to keep every
+// pool thread busy about this many times over, rather than one tile with a barrier after
+// it at a time
+constexpr std::size_t grid_bands_per_worker = 4;
+
+// Tile edge in samples: explicit curves are cut into tiles of tile_samples pixels,
+// implicit grids into tile_samples x tile_samples cells and regions into as many texels
+constexpr std::size_t tile_samples = 128;
+
+// Region tiles are white at the region's opacity; the layer tints them with its color
+constexpr ImU32 region_mask_color = IM_COL32(255, 255, 255, 180);
+constexpr ImU32 region_color = IM_COL32(100, 150, 255, 255);
+
+enum class TileKind : std::uint8_t { Explicit, ImplicitGrid, ImplicitQuadtree, Region };
+
+// Indices of the tiles of size `tile` covering the canvas
+struct TileRange {
+  std::int64_t first_column;
+  std::int64_t last_column;
+  std::int64_t first_row;
+  std::int64_t last_row;
+};
+
+TileRange visible_tiles(const PlotView& view, double tile) {
+  const double half_width = view.canvas_size.x / (2.0 * view.zoom);
+  const double half_height = view.canvas_size.y / (2.0 * view.zoom);
+  const auto index = [tile](double position) {
+    return static_cast<std::int64_t>(std::floor(position / tile));
+  };
+  return {index(view.center.x - half_width),
+      index(view.center.x + half_width),
+      index(view.center.y - half_height),
+      index(view.center.y + half_height)};
+}
+
+TileKey tile_key(std::uint64_t revision,
+    TileKind kind,
+    double step,
+    std::int64_t column,
+    std::int64_t row,
+    double bound = 0.0) {
+  return {revision,
+      std::bit_cast<std::uint64_t>(step),
+      std::bit_cast<std::uint64_t>(bound),
+      column,
+      row,
+      static_cast<std::uint8_t>(kind)};
+}
+
+// Evaluates `expression` at every point of `inputs` (one array per variable), through
+// `batch` when the expression has a batch form and through exprtk point by point otherwise.
+void evaluate_points(const std::optional<BatchProgram>& batch,
+    exprtk::expression<double>& expression,
+    std::span<double* const> variables,
+    std::span<const double* const> inputs,
+    std::span<double> out,
+    BatchWorkspace& workspace) {
+  if (batch) {
+    batch->evaluate(inputs, out, workspace);
+    return;
+  }
+
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    for (std::size_t v = 0; v < variables.size(); ++v) {
+      *variables[v] = inputs[v][i];
+    }
+    out[i] = expression.value();
+  }
+}
+
+// Evaluates one coordinate of a curve at `samples` into `out`. A split curve evaluates its
+// parameter-independent parts into `invariants` first, unless `reuse` says they are
+// still there from an earlier call.
+void evaluate_curve(const std::optional<CurveProgram>& curve,
+    const std::optional<BatchProgram>& batch,
+    exprtk::expression<double>& expression,
+    double* variable,
+    std::span<const double> samples,
+    bool reuse,
+    std::vector<std::vector<double>>& invariants,
+    std::span<double> out,
+    BatchWorkspace& workspace) {
+  const std::array<double*, 1> variables{variable};
+  const std::array<const double*, 1> inputs{samples.data()};
+  if (!curve) {
+    evaluate_points(batch, expression, variables, inputs, out, workspace);
+    return;
+  }
+
+  if (!reuse) {
+    invariants.resize(curve->invariants.size());
+    for (std::size_t i = 0; i < invariants.size(); ++i) {
+      invariants[i].resize(samples.size());
+      curve->invariants[i].evaluate(inputs, invariants[i], workspace);
+    }
+  }
+
+  // The curve variable, then the invariants' values
+  std::vector<const double*>& residual_inputs = workspace.inputs;
+  residual_inputs.assign(1, samples.data());
+  for (const std::vector<double>& values : invariants) {
+    residual_inputs.push_back(values.data());
+  }
+  curve->bound.evaluate(residual_inputs, out, workspace);
+}
+
+}  // namespace
+
+PlotSampler::PlotSampler(ThreadPool& thread_pool)
+    : m_thread_pool(thread_pool), m_workers(thread_pool.size()) {}
+
+bool PlotSampler::sample(ExpressionCache& expressions,
+    const PlotView& view,
+    double coarseness,
+    const CancelToken& cancel,
+    PlotResult& out) {
+  APP_PROFILE_STAGE(Debug::Stage::Evaluation, "PlotSampler::sample");
+
+  CompiledPlot& plot = expressions.current();
+  Polylines& samples = out.samples;
+
+  // Tiles of an older expression can never be asked for again
+  if (expressions.revision() != m_tile_revision) {
+    m_tiles.clear();
+    m_tile_revision = expressions.revision();
+  }
+
+  samples.clear();
+  out.x_monotonic = false;
+  out.has_region = false;
+  m_evaluations = 0;
+
+  // Parametric and polar curves are broken wherever they leave the real plane
+  const auto add_sample = [&samples](double x, double y) {
+    if (std::isfinite(x) && std::isfinite(y)) {
+      samples.add_point(ImVec2(static_cast<float>(x), static_cast<float>(y)));
+    } else {
+      samples.end_strip();
+    }
+  };
+
+  switch (plot.mode) {
+    case PlotMode::Parametric: {
+      // (f(t), g(t))
+      const double t_min = -10.0;
+      const double t_max = 10.0;
+      const double t_step = 0.02;
+
+      sample_curve(plot, expressions.compiled_revision(), t_min, t_max, t_step);
+      for (std::size_t i = 0; i < m_parameters.size(); ++i) {
+        add_sample(m_first[i], m_second[i]);
+      }
+      samples.end_strip();
+      out.color = IM_COL32(64, 128, 199, 255);
+      break;
+    }
+    case PlotMode::Polar: {
+      const double theta_min = 0.0;
+      const double theta_max = 4.0 * std::numbers::pi;
+      const double theta_step = 0.02;
+
+      sample_curve(plot, expressions.compiled_revision(), theta_min, theta_max, theta_step);
+      for (std::size_t i = 0; i < m_parameters.size(); ++i) {
+        const double r = m_first[i];
+        add_sample(r * std::cos(m_parameters[i]), r * std::sin(m_parameters[i]));
+      }
+      samples.end_strip();
+      out.color = IM_COL32(128, 64, 199, 255);
+      break;
+    }
+    case PlotMode::Explicit: {
+      if (!sample_explicit_tiles(plot, view, coarseness, cancel, samples)) {
+        return false;
+      }
+      out.color = IM_COL32(199, 68, 64, 255);
+      out.x_monotonic = true;
+      break;
+    }
+    case PlotMode::Implicit: {
+      if (!sample_implicit_tiles(expressions, view, coarseness, cancel, samples)) {
+        return false;
+      }
+      out.color = IM_COL32(64, 199, 128, 255);
+      break;
+    }
+    case PlotMode::Inequality: {
+      if (!sample_region_tiles(expressions, view, coarseness, cancel, out.region)) {
+        return false;
+      }
+      out.color = region_color;
+      out.has_region = out.region.columns > 0 && out.region.rows > 0;
+      break;
+    }
+    default:
+      break;
+  }
+
+  return !cancel.cancelled();
+}
+
+bool PlotSampler::is_view_dependent(PlotMode mode) {
+  return mode == PlotMode::Explicit || mode == PlotMode::Implicit ||
+         mode == PlotMode::Inequality;
+}
+
+void PlotSampler::set_tile_cache_capacity(std::size_t bytes) {
+  m_tiles.set_capacity(bytes);
+}
+
+void PlotSampler::clear_tiles() {
+  m_tiles.clear();
+}
+
+std::size_t PlotSampler::evaluations() const {
+  return m_evaluations;
+}
+
+bool PlotSampler::sample_explicit_tiles(CompiledPlot& plot,
+    const PlotView& view,
+    double coarseness,
+    const CancelToken& cancel,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  SamplerSettings settings;
+  settings.pixels_per_unit = view.zoom / coarseness;
+  // Fixed per zoom level rather than following the view, so tiles stay valid while panning.
+  // It follows the canvas height, which is why it is part of the tile key.
+  settings.y_limit = 1000.0 * view.canvas_size.y / view.zoom;
+
+  const double tile = static_cast<double>(tile_samples) / settings.pixels_per_unit;
+  const TileRange tiles = visible_tiles(view, tile);
+
+  // The initial samples of a tile go through the batch program, refinement is one x at a
+  // time since every split depends on the values before it
+  const std::function<double(double)> f = [&plot](double x) {
+    plot.x = x;
+    return plot.primary.value();
+  };
+  const std::array<double*, 1> variables{&plot.x};
+  BatchWorkspace& workspace = m_workers.front().batch;
+  const BatchFunction f_batch = [&plot, &variables, &workspace](std::span<const double> xs,
+                                    std::span<double> ys) {
+    const std::array<const double*, 1> inputs{xs.data()};
+    evaluate_points(plot.primary_batch, plot.primary, variables, inputs, ys, workspace);
+  };
+
+  for (std::int64_t column = tiles.first_column; column <= tiles.last_column; ++column) {
+    if (cancel.cancelled()) {
+      return false;
+    }
+
+    const TileKey key =
+        tile_key(m_tile_revision, TileKind::Explicit, tile, column, 0, settings.y_limit);
+    const Tile* cached = m_tiles.find(key);
+    if (cached == nullptr) {
+      Tile fresh;
+      settings.x_min = static_cast<double>(column) * tile;
+      settings.x_max = static_cast<double>(column + 1) * tile;
+      m_evaluations += sample_explicit(f, f_batch, settings, fresh.samples);
+      cached = &m_tiles.insert(key, std::move(fresh));
+    }
+    out.append(cached->samples);
+  }
+  return true;
+}
+
+bool PlotSampler::sample_implicit_tiles(ExpressionCache& expressions,
+    const PlotView& view,
+    double coarseness,
+    const CancelToken& cancel,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  // f(x,y) = g(x,y), compiled as f - g
+  CompiledPlot& plot = expressions.current();
+  const bool quadtree = view.implicit_engine == ImplicitEngine::Quadtree && plot.primary_tree;
+
+  // The quadtree's cost follows the curve length, so its leaves can be a single pixel
+  // wide; the dense grid keeps a floor on its step
+  const double step = quadtree ? coarseness / view.zoom
+                               : std::max(0.008, 1.0 / view.zoom) * coarseness;
+  const double tile = static_cast<double>(tile_samples) * step;
+  const TileKind kind = quadtree ? TileKind::ImplicitQuadtree : TileKind::ImplicitGrid;
+
+  const TileRange tiles = visible_tiles(view, tile);
+
+  // Strips are independent of each other, so cached tiles are appended right away and
+  // missing grid tiles after them, once their batch is evaluated
+  m_missing_tiles.clear();
+  for (std::int64_t row = tiles.first_row; row <= tiles.last_row; ++row) {
+    for (std::int64_t column = tiles.first_column; column <= tiles.last_column; ++column) {
+      if (cancel.cancelled()) {
+        return false;
+      }
+
+      const TileKey key = tile_key(m_tile_revision, kind, step, column, row);
+      const Tile* cached = m_tiles.find(key);
+      if (cached != nullptr) {
+        out.append(cached->samples);
+        continue;
+      }
+
+      const double x_min = static_cast<double>(column) * tile;
+      const double y_min = static_cast<double>(row) * tile;
+      if (!quadtree) {
+        m_missing_tiles.push_back({key, x_min, y_min, column, row});
+        continue;
+      }
+
+      QuadtreeSettings settings;
+      settings.x_min = x_min;
+      settings.x_max = x_min + tile;
+      settings.y_min = y_min;
+      settings.y_max = y_min + tile;
+      settings.step = step;
+
+      Tile fresh;
+      const QuadtreeStats stats = m_quadtree.extract(
+          *plot.primary_tree,
+          [&plot](double x, double y) {
+            plot.x = x;
+            plot.y = y;
+            return plot.primary.value();
+          },
+          settings,
+          fresh.samples);
+      m_evaluations += stats.point_evaluations;
+      out.append(m_tiles.insert(key, std::move(fresh)).samples);
+    }
+  }
+
+  if (m_missing_tiles.empty()) {
+    return true;
+  }
+
+  // Tiles have tile_samples + 1 rows of nodes
+  const std::size_t bands_per_tile = (tile_samples + grid_band_rows) / grid_band_rows;
+  const std::size_t batch_size = std::max<std::size_t>(
+      1, grid_bands_per_worker * m_thread_pool.size() / bands_per_tile);
+  const std::span<CompiledPlot* const> instances = expressions.instances(m_thread_pool.size());
+  for (std::size_t first = 0; first < m_missing_tiles.size(); first += batch_size) {
+    const std::span<const MissingTile> batch = std::span(m_missing_tiles).subspan(
+        first, std::min(batch_size, m_missing_tiles.size() - first));
+    if (m_grids.size() < batch.size()) {
+      m_grids.resize(batch.size());
+    }
+
+    // Every grid node is evaluated exactly once; the last row and column of nodes are
+    // shared with the neighbouring tiles
+    const std::span<ScalarGrid> grids = std::span(m_grids).first(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      grids[i].x_min = batch[i].x_min;
+      grids[i].y_min = batch[i].y_min;
+      grids[i].step = step;
+      grids[i].resize(tile_samples + 1, tile_samples + 1);
+    }
+
+    sample_grids(grids, instances, cancel);
+    if (cancel.cancelled()) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      Tile fresh;
+      m_evaluations += grids[i].values.size();
+      m_contours.extract(grids[i], fresh.samples);
+      out.append(m_tiles.insert(batch[i].key, std::move(fresh)).samples);
+    }
+  }
+  return true;
+}
+
+bool PlotSampler::sample_region_tiles(ExpressionCache& expressions,
+    const PlotView& view,
+    double coarseness,
+    const CancelToken& cancel,
+    RegionMask& out) {
+  APP_PROFILE_FUNCTION();
+
+  // One texel per two pixels at full detail; only the boundary cells are supersampled
+  const double step = 2.0 * coarseness / view.zoom;
+  const double tile = static_cast<double>(tile_samples) * step;
+
+  const TileRange tiles = visible_tiles(view, tile);
+
+  // The visible tiles are copied into one mask so the layer can draw a single texture
+  out.x_min = static_cast<double>(tiles.first_column) * tile;
+  out.y_min = static_cast<double>(tiles.first_row) * tile;
+  out.step = step;
+  out.columns = static_cast<std::size_t>(tiles.last_column - tiles.first_column + 1) * tile_samples;
+  out.rows = static_cast<std::size_t>(tiles.last_row - tiles.first_row + 1) * tile_samples;
+  out.pixels.resize(out.columns * out.rows);
+
+  const std::span<CompiledPlot* const> instances = expressions.instances(m_thread_pool.size());
+  const RegionFunction f = [this, instances](std::size_t worker,
+                               std::span<const double> xs,
+                               std::span<const double> ys,
+                               std::span<double> values) {
+    CompiledPlot& instance = *instances[worker];
+    const std::array<double*, 2> variables{&instance.x, &instance.y};
+    const std::array<const double*, 2> inputs{xs.data(), ys.data()};
+    evaluate_points(instance.primary_batch,
+        instance.primary,
+        variables,
+        inputs,
+        values,
+        m_workers[worker].batch);
+  };
+
+  // Mask rows run from the top, so the highest tile row comes first
+  const auto copy_tile = [&out, &tiles](const RegionMask& region,
+                             std::int64_t column,
+                             std::int64_t row) {
+    const auto first_column =
+        static_cast<std::size_t>(column - tiles.first_column) * tile_samples;
+    const auto first_row = static_cast<std::size_t>(tiles.last_row - row) * tile_samples;
+    for (std::size_t r = 0; r < region.rows && r < tile_samples; ++r) {
+      std::copy_n(region.pixels.begin() + static_cast<std::ptrdiff_t>(r * region.columns),
+          std::min(region.columns, tile_samples),
+          out.pixels.begin() +
+              static_cast<std::ptrdiff_t>((first_row + r) * out.columns + first_column));
+    }
+  };
+
+  // Cached tiles are copied right away and missing ones once their batch is rasterized
+  m_missing_tiles.clear();
+  for (std::int64_t row = tiles.first_row; row <= tiles.last_row; ++row) {
+    for (std::int64_t column = tiles.first_column; column <= tiles.last_column; ++column) {
+      if (cancel.cancelled()) {
+        return false;
+      }
+
+      const TileKey key = tile_key(m_tile_revision, TileKind::Region, step, column, row);
+      if (const Tile* cached = m_tiles.find(key)) {
+        copy_tile(cached->region, column, row);
+      } else {
+        m_missing_tiles.push_back({key,
+            static_cast<double>(column) * tile,
+            static_cast<double>(row) * tile,
+            column,
+            row});
+      }
+    }
+  }
+
+  const std::size_t bands_per_tile = (tile_samples + grid_band_rows - 1) / grid_band_rows;
+  const std::size_t batch_size = std::max<std::size_t>(
+      1, grid_bands_per_worker * m_thread_pool.size() / bands_per_tile);
+  for (std::size_t first = 0; first < m_missing_tiles.size(); first += batch_size) {
+    const std::span<const MissingTile> batch = std::span(m_missing_tiles).subspan(
+        first, std::min(batch_size, m_missing_tiles.size() - first));
+
+    // Every tile holds exactly tile_samples texels each way, whatever (max - min) / step
+    // rounds to
+    std::vector<Tile> fresh(batch.size());
+    m_region_settings.resize(batch.size());
+    m_region_masks.resize(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      RegionSettings& settings = m_region_settings[i];
+      settings.x_min = batch[i].x_min;
+      settings.x_max = batch[i].x_min + tile;
+      settings.y_min = batch[i].y_min;
+      settings.y_max = batch[i].y_min + tile;
+      settings.step = step;
+      settings.columns = tile_samples;
+      settings.rows = tile_samples;
+      settings.color = region_mask_color;
+      m_region_masks[i] = &fresh[i].region;
+    }
+
+    m_evaluations +=
+        m_region.rasterize(f, m_region_settings, m_region_masks, m_thread_pool, cancel);
+    if (cancel.cancelled()) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      const Tile& inserted = m_tiles.insert(batch[i].key, std::move(fresh[i]));
+      copy_tile(inserted.region, batch[i].column, batch[i].row);
+    }
+  }
+  return true;
+}
+
+// Evaluates the curve's coordinates at first, first + step, ... up to last into
+// m_first (and m_second for parametric curves).
+void PlotSampler::sample_curve(CompiledPlot& plot,
+    std::uint64_t compiled_revision,
+    double first,
+    double last,
+    double step) {
+  APP_PROFILE_FUNCTION();
+
+  m_parameters.clear();
+  // Accumulated like a plain for loop would, so the samples do not shift
+  for (double parameter = first; parameter <= last; parameter += step) {
+    m_parameters.push_back(parameter);
+  }
+  m_first.resize(m_parameters.size());
+  m_second.resize(m_parameters.size());
+
+  // The samples of a mode's curve are always the same, so only a new expression makes
+  // the values of its parameter-independent parts stale
+  const bool reuse = compiled_revision == m_invariant_revision;
+  m_invariant_revision = compiled_revision;
+
+  double* const parameter = plot.mode == PlotMode::Parametric ? &plot.t : &plot.theta;
+  BatchWorkspace& workspace = m_workers.front().batch;
+
+  evaluate_curve(plot.primary_curve,
+      plot.primary_batch,
+      plot.primary,
+      parameter,
+      m_parameters,
+      reuse,
+      m_first_invariants,
+      m_first,
+      workspace);
+  m_evaluations += m_first.size();
+  if (plot.mode == PlotMode::Parametric) {
+    evaluate_curve(plot.secondary_curve,
+        plot.secondary_batch,
+        plot.secondary,
+        parameter,
+        m_parameters,
+        reuse,
+        m_second_invariants,
+        m_second,
+        workspace);
+    m_evaluations += m_second.size();
+  }
+}
+
+// Fills `grids`, which are all the same size, in row bands: one loop over the bands of
+// every grid, one compiled instance per pool thread.
+void PlotSampler::sample_grids(std::span<ScalarGrid> grids,
+    std::span<CompiledPlot* const> instances,
+    const CancelToken& cancel) {
+  APP_PROFILE_FUNCTION();
+
+  const std::size_t columns = grids.front().columns;
+  const std::size_t bands = (grids.front().rows + grid_band_rows - 1) / grid_band_rows;
+  m_thread_pool.parallel_for(grids.size() * bands, [&](std::size_t task, std::size_t worker) {
+    if (cancel.cancelled()) {
+      return;
+    }
+
+    ScalarGrid& grid = grids[task / bands];
+    const std::size_t band = task % bands;
+    CompiledPlot& plot = *instances[worker];
+    WorkerBuffers& buffers = m_workers[worker];
+    buffers.x.resize(columns);
+    buffers.y.resize(columns);
+    for (std::size_t column = 0; column < columns; ++column) {
+      buffers.x[column] = grid.x(column);
+    }
+
+    const std::array<double*, 2> variables{&plot.x, &plot.y};
+    const std::array<const double*, 2> inputs{buffers.x.data(), buffers.y.data()};
+
+    const std::size_t last_row = std::min(grid.rows, (band + 1) * grid_band_rows);
+    for (std::size_t row = band * grid_band_rows; row < last_row; ++row) {
+      std::fill(buffers.y.begin(), buffers.y.end(), grid.y(row));
+      const std::span<double> values(grid.values.data() + row * columns, columns);
+      evaluate_points(
+          plot.primary_batch, plot.primary, variables, inputs, values, buffers.batch);
+    }
+  });
+}
+
+}  // namespace App::Plot
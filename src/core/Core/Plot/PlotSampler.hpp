@@ -0,0 +1,162 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Plot/BatchProgram.hpp"
+#include "Core/Plot/CancelToken.hpp"
+#include "Core/Plot/MarchingSquares.hpp"
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/Quadtree.hpp"
+#include "Core/Plot/RegionMask.hpp"
+#include "Core/Plot/TileCache.hpp"
+
+namespace App {
+class ThreadPool;
+}  // namespace App
+
+namespace App::Plot {
+
+struct CompiledPlot;
+class ExpressionCache;
+enum class PlotMode : std::uint8_t;
+
+// How implicit curves are extracted. The quadtree needs an expression within
+// ExpressionTree's subset and falls back to the grid otherwise.
+enum class ImplicitEngine : std::uint8_t { Grid, Quadtree };
+
+// What a plot's samples depend on besides the expression itself.
+struct PlotView {
+  float zoom{100.0F};
+  ImVec2 canvas_size{};
+  // World coordinates shown at the center of the canvas
+  ImVec2 center{};
+  ImplicitEngine implicit_engine{ImplicitEngine::Grid};
+
+  [[nodiscard]] bool operator==(const PlotView& other) const {
+    return zoom == other.zoom && canvas_size.x == other.canvas_size.x &&
+           canvas_size.y == other.canvas_size.y && center.x == other.center.x &&
+           center.y == other.center.y && implicit_engine == other.implicit_engine;
+  }
+};
+
+// World-space geometry of one evaluated plot: polylines for curves, a coverage mask for
+// inequalities.
+struct PlotResult {
+  Polylines samples;
+  ImU32 color{0};
+  // Every strip runs left to right, as for the graph of y = f(x)
+  bool x_monotonic{false};
+
+  RegionMask region;
+  bool has_region{false};
+};
+
+// Turns a compiled plot into a PlotResult for a given view. Bulk evaluations go through
+// the plot's BatchProgram when it has one. Keeps the scratch buffers of the grid, contour
+// and region passes so repeated sampling does not reallocate.
+//
+// The view-dependent modes are sampled per square world-space tile and the tiles are kept
+// in a TileCache, so panning only evaluates the tiles that scroll into view. Tiles are
+// aligned to multiples of their size, which keeps the sample positions of a tile the same
+// wherever the view is.
+class PlotSampler {
+ public:
+  explicit PlotSampler(ThreadPool& thread_pool);
+
+  // Samples the current plot of `expressions`. The view-dependent modes space their
+  // samples `coarseness` times further apart than at full detail (1), which makes a
+  // preview roughly coarseness^2 times cheaper for the grid based modes.
+  //
+  // Returns false when `cancel` fired before the result was complete; `out` is then
+  // partially written and must not be shown.
+  bool sample(ExpressionCache& expressions,
+      const PlotView& view,
+      double coarseness,
+      const CancelToken& cancel,
+      PlotResult& out);
+
+  // Whether the samples of a plot in this mode have to be recomputed when the view
+  // changes. Parametric and polar curves cover a fixed parameter range.
+  [[nodiscard]] static bool is_view_dependent(PlotMode mode);
+
+  void set_tile_cache_capacity(std::size_t bytes);
+  // Drops every cached tile, so the next sample() starts from scratch.
+  void clear_tiles();
+
+  // Point evaluations made by the last sample() call; cached tiles cost none.
+  [[nodiscard]] std::size_t evaluations() const;
+
+ private:
+  void sample_curve(CompiledPlot& plot,
+      std::uint64_t compiled_revision,
+      double first,
+      double last,
+      double step);
+  bool sample_explicit_tiles(CompiledPlot& plot,
+      const PlotView& view,
+      double coarseness,
+      const CancelToken& cancel,
+      Polylines& out);
+  bool sample_implicit_tiles(ExpressionCache& expressions,
+      const PlotView& view,
+      double coarseness,
+      const CancelToken& cancel,
+      Polylines& out);
+  bool sample_region_tiles(ExpressionCache& expressions,
+      const PlotView& view,
+      double coarseness,
+      const CancelToken& cancel,
+      RegionMask& out);
+  void sample_grids(std::span<ScalarGrid> grids,
+      std::span<CompiledPlot* const> instances,
+      const CancelToken& cancel);
+
+  struct WorkerBuffers {
+    BatchWorkspace batch;
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  ThreadPool& m_thread_pool;
+  std::vector<WorkerBuffers> m_workers;
+
+  // A grid or region tile that was not cached, waiting for its batch to be evaluated
+  struct MissingTile {
+    TileKey key;
+    double x_min{0.0};
+    double y_min{0.0};
+    std::int64_t column{0};
+    std::int64_t row{0};
+  };
+
+  std::vector<MissingTile> m_missing_tiles;
+  // One per tile of the largest batch so far
+  std::vector<ScalarGrid> m_grids;
+  ContourExtractor m_contours;
+  QuadtreeContourer m_quadtree;
+  RegionRasterizer m_region;
+  // Settings and masks of the region tiles of one batch
+  std::vector<RegionSettings> m_region_settings;
+  std::vector<RegionMask*> m_region_masks;
+
+  TileCache m_tiles;
+  std::uint64_t m_tile_revision{0};
+  std::size_t m_evaluations{0};
+
+  // Parameter values and both coordinates of a parametric or polar curve
+  std::vector<double> m_parameters;
+  std::vector<double> m_first;
+  std::vector<double> m_second;
+  // Values of the curve's parameter-independent parts at m_parameters, valid for the
+  // expression compiled at m_invariant_revision
+  std::vector<std::vector<double>> m_first_invariants;
+  std::vector<std::vector<double>> m_second_invariants;
+  std::uint64_t m_invariant_revision{0};
+};
+
+}  // namespace App::Plot
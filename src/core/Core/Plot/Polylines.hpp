@@ -0,0 +1,66 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace App::Plot {
+
+// A set of polylines stored back to back in one point buffer. Strips with fewer than
+// two points are dropped when they are closed since there is nothing to draw for them.
+struct Polylines {
+  std::vector<ImVec2> points;
+  // One past the index of the last point of every closed strip
+  std::vector<std::uint32_t> ends;
+
+  void clear() {
+    points.clear();
+    ends.clear();
+  }
+
+  void add_point(const ImVec2& point) {
+    points.push_back(point);
+  }
+
+  void end_strip() {
+    const std::uint32_t start = ends.empty() ? 0U : ends.back();
+    if (points.size() - start < 2) {
+      points.resize(start);
+      return;
+    }
+    ends.push_back(static_cast<std::uint32_t>(points.size()));
+  }
+
+  // Copies every strip of `other` after the closed strips of this set.
+  void append(const Polylines& other) {
+    const auto offset = static_cast<std::uint32_t>(points.size());
+    points.insert(points.end(), other.points.begin(), other.points.end());
+    for (const std::uint32_t end : other.ends) {
+      ends.push_back(offset + end);
+    }
+  }
+
+  [[nodiscard]] std::size_t strip_count() const {
+    return ends.size();
+  }
+
+  [[nodiscard]] std::span<const ImVec2> strip(std::size_t index) const {
+    const std::uint32_t start = index == 0 ? 0U : ends[index - 1];
+    return {points.data() + start, ends[index] - start};
+  }
+
+  // Points of the longest strip, e.g. to size scratch buffers for all of them.
+  [[nodiscard]] std::size_t longest_strip() const {
+    std::size_t longest = 0;
+    for (std::size_t i = 0; i < ends.size(); ++i) {
+      longest = std::max(longest, strip(i).size());
+    }
+    return longest;
+  }
+};
+
+}  // namespace App::Plot
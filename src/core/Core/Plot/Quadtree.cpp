@@ -0,0 +1,78 @@
+#include "Quadtree.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/Interval.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+QuadtreeStats QuadtreeContourer::extract(const ExpressionTree& tree,
+    const std::function<double(double, double)>& f,
+    const QuadtreeSettings& settings,
+    Polylines& out) {
+  APP_PROFILE_FUNCTION();
+
+  m_settings = settings;
+  m_stats = {};
+  m_cells.x_min = settings.x_min;
+  m_cells.y_min = settings.y_min;
+  m_cells.step = settings.step;
+  m_cells.cells.clear();
+
+  m_columns =
+      static_cast<std::uint32_t>(std::ceil((settings.x_max - settings.x_min) / settings.step));
+  m_rows = static_cast<std::uint32_t>(std::ceil((settings.y_max - settings.y_min) / settings.step));
+
+  const std::uint32_t root_size = 1U << settings.root_level;
+  for (std::uint32_t row = 0; row < m_rows; row += root_size) {
+    for (std::uint32_t column = 0; column < m_columns; column += root_size) {
+      subdivide(tree, column, row, settings.root_level);
+    }
+  }
+
+  m_stats.leaves = m_cells.cells.size();
+  m_stats.point_evaluations = m_contours.extract(m_cells, f, out);
+  return m_stats;
+}
+
+void QuadtreeContourer::subdivide(const ExpressionTree& tree,
+    std::uint32_t column,
+    std::uint32_t row,
+    std::uint32_t level) {
+  if (column >= m_columns || row >= m_rows) {
+    return;
+  }
+
+  const std::uint32_t size = 1U << level;
+  const double step = m_settings.step;
+  const std::array<Interval, 2> box{
+      Interval{m_settings.x_min + static_cast<double>(column) * step,
+          m_settings.x_min + static_cast<double>(column + size) * step},
+      Interval{m_settings.y_min + static_cast<double>(row) * step,
+          m_settings.y_min + static_cast<double>(row + size) * step},
+  };
+
+  ++m_stats.interval_evaluations;
+  if (!tree.evaluate(box, m_scratch).contains(0.0)) {
+    return;
+  }
+
+  if (level == 0) {
+    m_cells.cells.push_back({column, row});
+    return;
+  }
+
+  const std::uint32_t half = size / 2;
+  subdivide(tree, column, row, level - 1);
+  subdivide(tree, column + half, row, level - 1);
+  subdivide(tree, column, row + half, level - 1);
+  subdivide(tree, column + half, row + half, level - 1);
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/Interval.hpp"
+#include "Core/Plot/MarchingSquares.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+namespace App::Plot {
+
+struct QuadtreeSettings {
+  double x_min{-1.0};
+  double x_max{1.0};
+  double y_min{-1.0};
+  double y_max{1.0};
+  // Size of the leaf cells in world units
+  double step{0.01};
+  // Root cells are 2^root_level leaves wide
+  std::uint32_t root_level{6};
+};
+
+struct QuadtreeStats {
+  std::size_t interval_evaluations{0};
+  std::size_t point_evaluations{0};
+  std::size_t leaves{0};
+};
+
+// Adaptive implicit plotting for f(x, y) = 0. Cells are bounded with interval arithmetic
+// over the expression tree and discarded as soon as 0 is provably outside the bound, so
+// only cells near the curve are subdivided down to leaf size. The surviving leaves are
+// marched like a regular grid. The cost follows the length of the curve instead of the
+// area of the view.
+class QuadtreeContourer {
+ public:
+  // `tree` bounds f over cells and must use variable 0 for x and 1 for y; `f` provides the
+  // point values of the leaf corners.
+  QuadtreeStats extract(const ExpressionTree& tree,
+      const std::function<double(double, double)>& f,
+      const QuadtreeSettings& settings,
+      Polylines& out);
+
+ private:
+  void subdivide(const ExpressionTree& tree,
+      std::uint32_t column,
+      std::uint32_t row,
+      std::uint32_t level);
+
+  QuadtreeSettings m_settings;
+  QuadtreeStats m_stats;
+  std::uint32_t m_columns{0};
+  std::uint32_t m_rows{0};
+
+  SparseCells m_cells;
+  ContourExtractor m_contours;
+  std::vector<Interval> m_scratch;
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,195 @@
+#include "RegionMask.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/ThreadPool.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+constexpr std::size_t band_rows = 16;
+
+bool holds(double value) {
+  return value != 0.0 && !std::isnan(value);
+}
+
+std::uint32_t with_coverage(ImU32 color, unsigned int covered, unsigned int samples) {
+  const unsigned int alpha = (color >> 24U) * covered / samples;
+  return (color & 0x00FFFFFFU) | (alpha << 24U);
+}
+
+// Lower left corner of texel (column, row); rows count from the top
+double cell_x(const RegionMask& mask, std::size_t column) {
+  return mask.x_min + static_cast<double>(column) * mask.step;
+}
+
+double cell_y(const RegionMask& mask, std::size_t row) {
+  return mask.y_min + static_cast<double>(mask.rows - 1 - row) * mask.step;
+}
+
+}  // namespace
+
+std::size_t RegionRasterizer::rasterize(const RegionFunction& f,
+    const RegionSettings& settings,
+    RegionMask& mask,
+    ThreadPool& pool,
+    const CancelToken& cancel) {
+  RegionMask* const masks[] = {&mask};
+  return rasterize(f, std::span(&settings, 1), masks, pool, cancel);
+}
+
+std::size_t RegionRasterizer::rasterize(const RegionFunction& f,
+    std::span<const RegionSettings> settings,
+    std::span<RegionMask* const> masks,
+    ThreadPool& pool,
+    const CancelToken& cancel) {
+  APP_PROFILE_FUNCTION();
+
+  const auto cells = [](double min, double max, double step) {
+    return static_cast<std::size_t>(std::ceil((max - min) / step));
+  };
+
+  m_inside.resize(masks.size());
+  m_first_band.assign(masks.size() + 1, 0);
+  for (std::size_t i = 0; i < masks.size(); ++i) {
+    const RegionSettings& mask_settings = settings[i];
+    RegionMask& mask = *masks[i];
+    mask.x_min = mask_settings.x_min;
+    mask.y_min = mask_settings.y_min;
+    mask.step = mask_settings.step;
+    mask.columns = mask_settings.columns != 0
+                       ? mask_settings.columns
+                       : cells(mask_settings.x_min, mask_settings.x_max, mask_settings.step);
+    mask.rows = mask_settings.rows != 0
+                    ? mask_settings.rows
+                    : cells(mask_settings.y_min, mask_settings.y_max, mask_settings.step);
+    mask.pixels.resize(mask.columns * mask.rows);
+    m_inside[i].resize(mask.columns * mask.rows);
+    m_first_band[i + 1] = m_first_band[i] + (mask.rows + band_rows - 1) / band_rows;
+  }
+
+  const std::size_t bands = m_first_band.back();
+  m_workers.resize(pool.size());
+  std::vector<std::size_t> band_evaluations(bands, 0);
+
+  // The mask a band of all masks' bands belongs to, and its band within that mask
+  const auto locate = [this](std::size_t task) {
+    const auto next = std::upper_bound(m_first_band.begin(), m_first_band.end(), task);
+    const auto mask = static_cast<std::size_t>(next - m_first_band.begin()) - 1;
+    return std::pair{mask, task - m_first_band[mask]};
+  };
+
+  pool.parallel_for(bands, [&](std::size_t task, std::size_t worker) {
+    if (cancel.cancelled()) {
+      return;
+    }
+
+    const auto [index, band] = locate(task);
+    const RegionMask& mask = *masks[index];
+    std::vector<std::uint8_t>& inside = m_inside[index];
+    const std::size_t columns = mask.columns;
+
+    WorkerBuffers& buffers = m_workers[worker];
+    buffers.x.resize(columns);
+    buffers.y.resize(columns);
+    buffers.values.resize(columns);
+    for (std::size_t column = 0; column < columns; ++column) {
+      buffers.x[column] = cell_x(mask, column) + 0.5 * mask.step;
+    }
+
+    const std::size_t last_row = std::min(mask.rows, (band + 1) * band_rows);
+    for (std::size_t row = band * band_rows; row < last_row; ++row) {
+      std::fill(buffers.y.begin(), buffers.y.end(), cell_y(mask, row) + 0.5 * mask.step);
+      f(worker, buffers.x, buffers.y, buffers.values);
+
+      for (std::size_t column = 0; column < columns; ++column) {
+        inside[row * columns + column] = holds(buffers.values[column]) ? 1 : 0;
+      }
+      band_evaluations[task] += columns;
+    }
+  });
+
+  // The second pass only reads the classification, so bands can look across their edges
+  pool.parallel_for(bands, [&](std::size_t task, std::size_t worker) {
+    if (cancel.cancelled()) {
+      return;
+    }
+
+    const auto [index, band] = locate(task);
+    const RegionSettings& mask_settings = settings[index];
+    RegionMask& mask = *masks[index];
+    const std::vector<std::uint8_t>& inside = m_inside[index];
+    const std::size_t columns = mask.columns;
+    const std::size_t rows = mask.rows;
+
+    const ImU32 outside_color = mask_settings.color & 0x00FFFFFFU;
+    const auto refinement = static_cast<unsigned int>(std::max(1, mask_settings.refinement));
+    const unsigned int samples = refinement * refinement;
+    const double sub_step = mask.step / static_cast<double>(refinement);
+
+    WorkerBuffers& buffers = m_workers[worker];
+    const std::size_t last_row = std::min(rows, (band + 1) * band_rows);
+
+    for (std::size_t row = band * band_rows; row < last_row; ++row) {
+      buffers.cells.clear();
+      for (std::size_t column = 0; column < columns; ++column) {
+        const std::size_t cell = row * columns + column;
+        const std::uint8_t classification = inside[cell];
+
+        const bool boundary =
+            (column > 0 && inside[cell - 1] != classification) ||
+            (column + 1 < columns && inside[cell + 1] != classification) ||
+            (row > 0 && inside[cell - columns] != classification) ||
+            (row + 1 < rows && inside[cell + columns] != classification);
+        if (boundary) {
+          buffers.cells.push_back(column);
+        } else {
+          mask.pixels[cell] = classification != 0 ? mask_settings.color : outside_color;
+        }
+      }
+      if (buffers.cells.empty()) {
+        continue;
+      }
+
+      // All sub-samples of the row's boundary cells go through f in one call
+      const std::size_t points = buffers.cells.size() * samples;
+      buffers.x.resize(points);
+      buffers.y.resize(points);
+      buffers.values.resize(points);
+
+      std::size_t point = 0;
+      for (const std::size_t column : buffers.cells) {
+        for (unsigned int sy = 0; sy < refinement; ++sy) {
+          const double y = cell_y(mask, row) + (static_cast<double>(sy) + 0.5) * sub_step;
+          for (unsigned int sx = 0; sx < refinement; ++sx) {
+            buffers.x[point] = cell_x(mask, column) + (static_cast<double>(sx) + 0.5) * sub_step;
+            buffers.y[point] = y;
+            ++point;
+          }
+        }
+      }
+      f(worker, buffers.x, buffers.y, buffers.values);
+      band_evaluations[task] += points;
+
+      for (std::size_t cell = 0; cell < buffers.cells.size(); ++cell) {
+        const auto first = buffers.values.begin() + static_cast<std::ptrdiff_t>(cell * samples);
+        const auto covered =
+            static_cast<unsigned int>(std::count_if(first, first + samples, holds));
+        mask.pixels[row * columns + buffers.cells[cell]] =
+            with_coverage(mask_settings.color, covered, samples);
+      }
+    }
+  });
+
+  return std::accumulate(band_evaluations.begin(), band_evaluations.end(), std::size_t{0});
+}
+
+}  // namespace App::Plot
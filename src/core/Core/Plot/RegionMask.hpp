@@ -0,0 +1,97 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "Core/Plot/CancelToken.hpp"
+
+namespace App {
+class ThreadPool;
+}  // namespace App
+
+namespace App::Plot {
+
+// Coverage of the region where a predicate holds, one texel per grid cell. Rows are
+// stored top (y_max) to bottom so `pixels` can be uploaded to a texture as is.
+struct RegionMask {
+  double x_min{0.0};
+  double y_min{0.0};
+  double step{1.0};
+  std::size_t columns{0};
+  std::size_t rows{0};
+
+  // IM_COL32 packed colors
+  std::vector<std::uint32_t> pixels;
+
+  [[nodiscard]] double x_max() const {
+    return x_min + static_cast<double>(columns) * step;
+  }
+  [[nodiscard]] double y_max() const {
+    return y_min + static_cast<double>(rows) * step;
+  }
+};
+
+struct RegionSettings {
+  double x_min{-1.0};
+  double x_max{1.0};
+  double y_min{-1.0};
+  double y_max{1.0};
+  double step{0.01};
+  // Texels across and down; 0 takes as many as it takes to cover [min, max]. Tiles give
+  // theirs, since (max - min) / step can round up to one more than they hold.
+  std::size_t columns{0};
+  std::size_t rows{0};
+  // Cells on the boundary are supersampled with refinement x refinement samples
+  int refinement{4};
+  ImU32 color{IM_COL32(100, 150, 255, 180)};
+};
+
+// f(worker, xs, ys, values) evaluates the predicate at every (xs[i], ys[i]); `worker`
+// identifies the pool thread making the call.
+using RegionFunction = std::function<void(
+    std::size_t, std::span<const double>, std::span<const double>, std::span<double>)>;
+
+// Rasterizes { (x, y) | f(x, y) != 0 } into a RegionMask. Every cell is first classified
+// by its center; only cells whose classification differs from a neighbour are
+// supersampled to anti-alias the boundary. `f` is called with a whole row of centers, or
+// with all sub-samples of a row's boundary cells, at a time.
+//
+// Both passes are split into row bands across the pool; every band writes its own rows,
+// so the result does not depend on the number of threads. Bands started after `cancel`
+// fires are skipped and leave the mask incomplete.
+class RegionRasterizer {
+ public:
+  // Returns the number of points `f` was evaluated at.
+  std::size_t rasterize(const RegionFunction& f,
+      const RegionSettings& settings,
+      RegionMask& mask,
+      ThreadPool& pool,
+      const CancelToken& cancel = {});
+  // Rasterizes masks[i] with settings[i], spreading the bands of all of them over the
+  // pool at once rather than waiting for each mask in turn.
+  std::size_t rasterize(const RegionFunction& f,
+      std::span<const RegionSettings> settings,
+      std::span<RegionMask* const> masks,
+      ThreadPool& pool,
+      const CancelToken& cancel = {});
+
+ private:
+  struct WorkerBuffers {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> values;
+    std::vector<std::size_t> cells;
+  };
+
+  // Per mask: the cell centers' classification, and the index of its first band
+  std::vector<std::vector<std::uint8_t>> m_inside;
+  std::vector<std::size_t> m_first_band;
+  std::vector<WorkerBuffers> m_workers;
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,37 @@
+#include "SharedSymbols.hpp"
+
+#include <cmath>
+#include <numbers>
+
+#include "exprtk.hpp"
+
+namespace App::Plot {
+
+SharedSymbols::NaturalLog::NaturalLog() : exprtk::ifunction<double>(1) {
+  // Pure, so calls with constant arguments are folded when compiling
+  exprtk::disable_has_side_effects(*this);
+}
+
+double SharedSymbols::NaturalLog::operator()(const double& value) {
+  return std::log(value);
+}
+
+SharedSymbols::SharedSymbols() {
+  m_symbols.add_constants();
+  // "pi" is already added by add_constants()
+  m_symbols.add_constant("π", std::numbers::pi);
+  m_symbols.add_constant("e", std::numbers::e);
+  m_symbols.add_constant("phi", std::numbers::phi);
+  m_symbols.add_constant("ϕ", std::numbers::phi);
+  m_symbols.add_constant("φ", std::numbers::phi);
+  m_symbols.add_constant("gamma", std::numbers::egamma);
+  m_symbols.add_constant("γ", std::numbers::egamma);
+
+  m_symbols.add_function("ln", m_ln);
+}
+
+void SharedSymbols::register_with(exprtk::expression<double>& expression) {
+  expression.register_symbol_table(m_symbols);
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+
+#include "exprtk.hpp"
+
+namespace App::Plot {
+
+// The constants and functions every plot can read, in one process-wide exprtk table that
+// each expression registers by reference instead of filling a table of its own: pi,
+// epsilon and inf from exprtk, e, π, phi (ϕ, φ) and gamma (γ), and the library functions
+// below. The table is built on first use and never changed afterwards, so expressions
+// reading it can be evaluated on any thread.
+//
+// exprtk counts the holders of a table without synchronization, though. Registering the
+// table with an expression, compiling an expression that has it registered and releasing
+// such an expression or its parser must happen while lock() is held.
+class SharedSymbols {
+ public:
+  [[nodiscard]] static SharedSymbols& get() {
+    static SharedSymbols instance;
+    return instance;
+  }
+
+  SharedSymbols(const SharedSymbols&) = delete;
+  SharedSymbols(SharedSymbols&&) = delete;
+  SharedSymbols& operator=(SharedSymbols other) = delete;
+  SharedSymbols& operator=(SharedSymbols&& other) = delete;
+
+  [[nodiscard]] std::unique_lock<std::mutex> lock() {
+    return std::unique_lock(m_mutex);
+  }
+
+  // Call with lock() held.
+  void register_with(exprtk::expression<double>& expression);
+
+ private:
+  // ln(x), the natural logarithm, as spelled in most textbooks
+  struct NaturalLog final : exprtk::ifunction<double> {
+    NaturalLog();
+    double operator()(const double& value) override;
+  };
+
+  SharedSymbols();
+  ~SharedSymbols() = default;
+
+  std::mutex m_mutex;
+  // Declared before the table, which refers to them
+  NaturalLog m_ln;
+  exprtk::symbol_table<double> m_symbols;
+};
+
+}  // namespace App::Plot
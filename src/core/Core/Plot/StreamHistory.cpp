@@ -0,0 +1,119 @@
+#include "StreamHistory.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "Core/Debug/Instrumentor.hpp"
+
+namespace App::Plot {
+
+StreamHistory::StreamHistory() : m_samples(capacity), m_buckets(capacity / bucket_size) {}
+
+void StreamHistory::append(const StreamSample& sample) {
+  if (!std::isfinite(sample.x)) {
+    return;
+  }
+  if (!empty() && sample.x < latest().x) {
+    clear();
+  }
+
+  m_samples[m_total % capacity] = sample;
+
+  DataBucket& bucket = m_buckets[(m_total / bucket_size) % m_buckets.size()];
+  if (m_total % bucket_size == 0) {
+    bucket = {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+  }
+  if (std::isfinite(sample.y)) {
+    constexpr double limit = std::numeric_limits<float>::max();
+    const auto y = static_cast<float>(std::clamp(sample.y, -limit, limit));
+    bucket.y_min = std::min(bucket.y_min, y);
+    bucket.y_max = std::max(bucket.y_max, y);
+  }
+
+  ++m_total;
+}
+
+void StreamHistory::clear() {
+  m_total = 0;
+}
+
+std::uint64_t StreamHistory::lower_bound(double x) const {
+  std::uint64_t low = first();
+  std::uint64_t high = end();
+  while (low < high) {
+    const std::uint64_t middle = low + (high - low) / 2;
+    if (sample(middle).x < x) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+std::uint64_t StreamHistory::upper_bound(double x) const {
+  std::uint64_t low = first();
+  std::uint64_t high = end();
+  while (low < high) {
+    const std::uint64_t middle = low + (high - low) / 2;
+    if (sample(middle).x <= x) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+bool StreamHistory::visible(double x_min, double x_max, double pixels, Polylines& out) const {
+  APP_PROFILE_FUNCTION();
+
+  if (empty() || !(x_min <= x_max) || !(pixels > 0.0)) {
+    return false;
+  }
+
+  std::uint64_t start = lower_bound(x_min);
+  std::uint64_t stop = upper_bound(x_max);
+  if (start > first()) {
+    --start;
+  }
+  if (stop < end()) {
+    ++stop;
+  }
+  if (start >= stop) {
+    return false;
+  }
+
+  if (static_cast<double>(stop - start) / pixels < static_cast<double>(bucket_size)) {
+    for (std::uint64_t i = start; i < stop; ++i) {
+      const StreamSample& point = sample(i);
+      if (std::isfinite(point.y)) {
+        out.add_point(ImVec2(static_cast<float>(point.x), static_cast<float>(point.y)));
+      } else {
+        out.end_strip();
+      }
+    }
+    out.end_strip();
+    return false;
+  }
+
+  // The oldest bucket may be partly overwritten, its extremes are no longer current
+  const std::uint64_t first_bucket =
+      std::max(start / bucket_size, (first() + bucket_size - 1) / bucket_size);
+  const std::uint64_t last_bucket = (stop - 1) / bucket_size;
+  BucketStrokes strokes(out);
+  for (std::uint64_t bucket = first_bucket; bucket <= last_bucket; ++bucket) {
+    strokes.add(m_buckets[bucket % m_buckets.size()],
+        static_cast<float>(sample(bucket * bucket_size).x),
+        static_cast<float>(sample(std::min((bucket + 1) * bucket_size, end()) - 1).x));
+  }
+  out.end_strip();
+  return true;
+}
+
+}  // namespace App::Plot
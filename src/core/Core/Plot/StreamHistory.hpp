@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Core/Plot/DataSeries.hpp"
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/StreamSource.hpp"
+
+namespace App::Plot {
+
+// The most recent samples of a stream, kept by the UI thread, along with min/max buckets
+// of bucket_size samples each that are updated as samples arrive rather than rebuilt per
+// frame. A window holding more than a bucket per pixel is drawn from the buckets, so a
+// frame costs about the canvas width however many samples are visible.
+//
+// Finding the visible samples relies on x never decreasing; a sample with a smaller x
+// than the last one, e.g. from a restarted simulation, starts the history over.
+class StreamHistory {
+ public:
+  static constexpr std::size_t capacity = 1U << 20U;
+  static constexpr std::size_t bucket_size = 64;
+
+  StreamHistory();
+
+  // Samples with a non-finite x are ignored, a non-finite y breaks the curve.
+  void append(const StreamSample& sample);
+  void clear();
+
+  [[nodiscard]] bool empty() const {
+    return m_total == 0;
+  }
+  // Index of the oldest sample still kept; indices count from the last clear().
+  [[nodiscard]] std::uint64_t first() const {
+    return m_total > capacity ? m_total - capacity : 0;
+  }
+  // One past the index of the newest sample.
+  [[nodiscard]] std::uint64_t end() const {
+    return m_total;
+  }
+  [[nodiscard]] const StreamSample& sample(std::uint64_t index) const {
+    return m_samples[index % capacity];
+  }
+  [[nodiscard]] const StreamSample& latest() const {
+    return sample(m_total - 1);
+  }
+
+  // Appends the samples with x in [x_min, x_max], plus one on either side, to `out` as
+  // polylines whose x never decreases. Returns true when they were drawn from buckets.
+  bool visible(double x_min, double x_max, double pixels, Polylines& out) const;
+
+ private:
+  // The first index in [first(), end()) whose x is not below `x`, or end()
+  [[nodiscard]] std::uint64_t lower_bound(double x) const;
+  [[nodiscard]] std::uint64_t upper_bound(double x) const;
+
+  std::vector<StreamSample> m_samples;
+  // Bucket b covers the samples [b * bucket_size, (b + 1) * bucket_size)
+  std::vector<DataBucket> m_buckets;
+  std::uint64_t m_total{0};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,93 @@
+#include "StreamLayer.hpp"
+
+#include <imgui.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/FrameArena.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+constexpr ImU32 stream_color = IM_COL32(214, 120, 30, 255);
+constexpr auto rate_interval = std::chrono::milliseconds(500);
+
+}  // namespace
+
+void StreamLayer::connect(StreamSettings settings, std::function<void()> on_data) {
+  // The old source's thread is joined before the new one starts reading
+  m_source.reset();
+  m_history.clear();
+  ++m_revision;
+  m_rate = 0.0;
+  m_rate_samples = 0;
+  m_rate_start = std::chrono::steady_clock::now();
+  m_source = std::make_unique<StreamSource>(std::move(settings), std::move(on_data));
+}
+
+void StreamLayer::disconnect() {
+  m_source.reset();
+}
+
+bool StreamLayer::update() {
+  APP_PROFILE_FUNCTION();
+
+  if (m_source == nullptr) {
+    return false;
+  }
+
+  const std::size_t count =
+      m_source->drain([this](const StreamSample& sample) { m_history.append(sample); });
+
+  if (count > 0) {
+    ++m_revision;
+  }
+  m_rate_samples += count;
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> elapsed = now - m_rate_start;
+  if (elapsed >= rate_interval) {
+    m_rate = static_cast<double>(m_rate_samples) / elapsed.count();
+    m_rate_samples = 0;
+    m_rate_start = now;
+  }
+
+  return count > 0;
+}
+
+void StreamLayer::draw(ImDrawList* draw_list,
+    const ImVec2& canvas_min,
+    const ImVec2& canvas_max,
+    const ImVec2& origin,
+    float zoom,
+    float thickness,
+    FrameArena& scratch) {
+  APP_PROFILE_FUNCTION();
+
+  if (m_history.empty() || canvas_max.x <= canvas_min.x) {
+    return;
+  }
+
+  m_visible.clear();
+  m_history.visible(static_cast<double>((canvas_min.x - origin.x) / zoom),
+      static_cast<double>((canvas_max.x - origin.x) / zoom),
+      static_cast<double>(canvas_max.x - canvas_min.x),
+      m_visible);
+
+  draw_world_polylines(draw_list,
+      m_visible,
+      origin,
+      zoom,
+      stream_color,
+      thickness,
+      /*x_monotonic=*/true,
+      m_decimator,
+      scratch);
+}
+
+}  // namespace App::Plot
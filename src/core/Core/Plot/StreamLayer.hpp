@@ -0,0 +1,65 @@
+#pragma once
+
+#include <imgui.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Decimation.hpp"
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/StreamHistory.hpp"
+#include "Core/Plot/StreamSource.hpp"
+
+namespace App::Plot {
+
+// Shows a live StreamSource over the plots. Every frame moves what arrived since the last
+// one into the StreamHistory, then draws the part of the history within the canvas.
+class StreamLayer {
+ public:
+  // Replaces the current source; `on_data` is handed to the new StreamSource.
+  void connect(StreamSettings settings, std::function<void()> on_data);
+  void disconnect();
+
+  [[nodiscard]] const StreamSource* source() const {
+    return m_source.get();
+  }
+  [[nodiscard]] const StreamHistory& history() const {
+    return m_history;
+  }
+  // Samples per second that reached the history, averaged over about half a second.
+  [[nodiscard]] double rate() const {
+    return m_rate;
+  }
+  // Changes whenever the history does.
+  [[nodiscard]] std::uint64_t revision() const {
+    return m_revision;
+  }
+
+  // Takes the new samples of the source. Returns whether there were any.
+  bool update();
+  void draw(ImDrawList* draw_list,
+      const ImVec2& canvas_min,
+      const ImVec2& canvas_max,
+      const ImVec2& origin,
+      float zoom,
+      float thickness,
+      FrameArena& scratch);
+
+ private:
+  std::unique_ptr<StreamSource> m_source;
+  StreamHistory m_history;
+  std::uint64_t m_revision{0};
+
+  double m_rate{0.0};
+  std::uint64_t m_rate_samples{0};
+  std::chrono::steady_clock::time_point m_rate_start;
+
+  Polylines m_visible;
+  PolylineDecimator m_decimator;
+};
+
+}  // namespace App::Plot
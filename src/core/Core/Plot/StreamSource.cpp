@@ -0,0 +1,201 @@
+#include "StreamSource.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Plot/CsvRow.hpp"
+#include "Core/StreamConnection.hpp"
+
+namespace App::Plot {
+
+namespace {
+
+// How long a read waits for data before checking whether the source is being stopped
+constexpr auto read_timeout = std::chrono::milliseconds(50);
+constexpr auto notify_interval = std::chrono::milliseconds(8);
+// How long a blocked reader waits for the UI to make room in the ring
+constexpr auto blocked_retry = std::chrono::microseconds(500);
+constexpr std::size_t read_buffer_size = 64 * 1024;
+constexpr std::size_t binary_record_size = 2 * sizeof(double);
+// Longer lines cannot be a sample, they are skipped without being buffered
+constexpr std::size_t max_line_length = 1024;
+
+}  // namespace
+
+StreamSource::StreamSource(StreamSettings settings, std::function<void()> on_data)
+    : m_settings(std::move(settings)),
+      m_on_data(std::move(on_data)) {
+  m_thread = std::thread([this] { read_loop(); });
+}
+
+StreamSource::~StreamSource() {
+  m_stopping.store(true, std::memory_order_relaxed);
+  m_thread.join();
+}
+
+StreamCounters StreamSource::counters() const {
+  StreamCounters counters;
+  counters.bytes = m_bytes.load(std::memory_order_relaxed);
+  counters.samples = m_samples.load(std::memory_order_relaxed);
+  counters.dropped = m_dropped.load(std::memory_order_relaxed);
+  counters.blocked = m_blocked.load(std::memory_order_relaxed);
+  counters.malformed = m_malformed.load(std::memory_order_relaxed);
+  return counters;
+}
+
+void StreamSource::read_loop() {
+  APP_PROFILE_FUNCTION();
+
+  StreamConnection connection(m_settings.endpoint, m_settings.path);
+  if (!connection.valid()) {
+    m_state.store(StreamState::Failed, std::memory_order_release);
+    return;
+  }
+  m_state.store(StreamState::Streaming, std::memory_order_release);
+
+  std::vector<std::byte> buffer(read_buffer_size);
+  while (!m_stopping.load(std::memory_order_relaxed)) {
+    const std::ptrdiff_t count = connection.read(buffer, read_timeout);
+    if (count < 0) {
+      break;
+    }
+    if (count > 0) {
+      m_bytes.fetch_add(static_cast<std::uint64_t>(count), std::memory_order_relaxed);
+      parse(std::span<const std::byte>(buffer.data(), static_cast<std::size_t>(count)));
+    }
+    notify(false);
+  }
+
+  // The last line of a text stream does not need a newline
+  if (m_settings.encoding == StreamEncoding::Text && !m_line.empty() && !m_line_too_long) {
+    parse_line(m_line);
+  }
+  notify(true);
+  m_state.store(StreamState::Ended, std::memory_order_release);
+}
+
+void StreamSource::parse(std::span<const std::byte> bytes) {
+  APP_PROFILE_FUNCTION();
+
+  if (m_settings.encoding == StreamEncoding::Binary) {
+    // Records can be split across reads
+    std::size_t offset = 0;
+    if (!m_record.empty()) {
+      offset = std::min(binary_record_size - m_record.size(), bytes.size());
+      const auto head = bytes.first(offset);
+      m_record.insert(m_record.end(), head.begin(), head.end());
+      if (m_record.size() < binary_record_size) {
+        return;
+      }
+      StreamSample sample;
+      std::memcpy(&sample.x, m_record.data(), sizeof(double));
+      std::memcpy(&sample.y, m_record.data() + sizeof(double), sizeof(double));
+      push(sample);
+      m_record.clear();
+    }
+
+    for (; offset + binary_record_size <= bytes.size(); offset += binary_record_size) {
+      StreamSample sample;
+      std::memcpy(&sample.x, bytes.data() + offset, sizeof(double));
+      std::memcpy(&sample.y, bytes.data() + offset + sizeof(double), sizeof(double));
+      push(sample);
+    }
+    const auto rest = bytes.subspan(offset);
+    m_record.assign(rest.begin(), rest.end());
+    return;
+  }
+
+  std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  while (!text.empty()) {
+    const std::size_t end = text.find('\n');
+    const std::string_view part = text.substr(0, end);
+    if (m_line.size() + part.size() > max_line_length) {
+      m_line_too_long = true;
+    } else if (!m_line_too_long) {
+      m_line.append(part);
+    }
+
+    if (end == std::string_view::npos) {
+      return;
+    }
+    text.remove_prefix(end + 1);
+
+    if (m_line_too_long) {
+      m_malformed.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      parse_line(m_line);
+    }
+    m_line.clear();
+    m_line_too_long = false;
+  }
+}
+
+void StreamSource::parse_line(std::string_view line) {
+  line = trim_blanks(line);
+  if (line.empty() || line.front() == '#') {
+    return;
+  }
+
+  const auto row = parse_csv_row(line);
+  if (!row) {
+    m_malformed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (row->columns == 1) {
+    push({static_cast<double>(m_next_index), row->first});
+  } else {
+    push({row->first, row->second});
+  }
+}
+
+void StreamSource::push(const StreamSample& sample) {
+  // Dropped samples still take up their index, which leaves a visible gap
+  ++m_next_index;
+
+  bool waited = false;
+  while (!m_ring.push(sample)) {
+    if (m_settings.overflow == StreamOverflow::Drop) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (!waited) {
+      m_blocked.fetch_add(1, std::memory_order_relaxed);
+      waited = true;
+    }
+    if (m_stopping.load(std::memory_order_relaxed)) {
+      return;
+    }
+    // The UI may be asleep waiting for events
+    notify(false);
+    std::this_thread::sleep_for(blocked_retry);
+  }
+
+  m_samples.fetch_add(1, std::memory_order_relaxed);
+  m_pending_notify = true;
+}
+
+void StreamSource::notify(bool force) {
+  if (!m_pending_notify || !m_on_data) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (force || now - m_last_notify >= notify_interval) {
+    m_on_data();
+    m_last_notify = now;
+    m_pending_notify = false;
+  }
+}
+
+}  // namespace App::Plot
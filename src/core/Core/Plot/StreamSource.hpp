@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Core/SpscRing.hpp"
+#include "Core/StreamConnection.hpp"
+
+namespace App::Plot {
+
+struct StreamSample {
+  double x{0.0};
+  double y{0.0};
+};
+
+// Text streams send one "y" or "x,y" line per sample, binary streams native-endian
+// (x, y) pairs of doubles. Without an x, the sample's number in the stream is used.
+enum class StreamEncoding : std::uint8_t { Text, Binary };
+
+// What the reading thread does while the ring is full: Drop discards the new sample,
+// Block stops reading so the writer is slowed down by the full pipe or socket instead.
+enum class StreamOverflow : std::uint8_t { Drop, Block };
+
+enum class StreamState : std::uint8_t { Connecting, Streaming, Ended, Failed };
+
+struct StreamSettings {
+  StreamEndpoint endpoint{StreamEndpoint::Stdin};
+  std::filesystem::path path;
+  StreamEncoding encoding{StreamEncoding::Text};
+  StreamOverflow overflow{StreamOverflow::Drop};
+};
+
+// Totals since the source was started.
+struct StreamCounters {
+  std::uint64_t bytes{0};
+  std::uint64_t samples{0};
+  // Discarded because the ring was full
+  std::uint64_t dropped{0};
+  // Samples the reading thread had to wait for room for
+  std::uint64_t blocked{0};
+  // Lines that are not a sample, e.g. headers
+  std::uint64_t malformed{0};
+};
+
+// Reads samples from a StreamConnection on a background thread into a lock-free ring,
+// which the UI thread drains once per frame. Ingestion never waits for frames: when the
+// UI falls behind by a whole ring, samples are dropped or the writer is held back as the
+// settings say, and either is counted.
+class StreamSource {
+ public:
+  static constexpr std::size_t ring_capacity = 1U << 16U;
+
+  // `on_data` is called from the reading thread when new samples arrived, at most about
+  // once per frame at 120 Hz.
+  explicit StreamSource(StreamSettings settings, std::function<void()> on_data = {});
+  ~StreamSource();
+
+  StreamSource(const StreamSource&) = delete;
+  StreamSource(StreamSource&&) = delete;
+  StreamSource& operator=(StreamSource other) = delete;
+  StreamSource& operator=(StreamSource&& other) = delete;
+
+  // Hands the samples read so far to `sink` in order. Only one thread may drain.
+  template <typename Sink>
+  std::size_t drain(Sink&& sink) {
+    return m_ring.drain(std::forward<Sink>(sink));
+  }
+
+  [[nodiscard]] StreamCounters counters() const;
+  [[nodiscard]] StreamState state() const {
+    return m_state.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] std::size_t queued() const {
+    return m_ring.size();
+  }
+  [[nodiscard]] const StreamSettings& settings() const {
+    return m_settings;
+  }
+
+ private:
+  void read_loop();
+  void parse(std::span<const std::byte> bytes);
+  void parse_line(std::string_view line);
+  void push(const StreamSample& sample);
+  void notify(bool force);
+
+  const StreamSettings m_settings;
+  const std::function<void()> m_on_data;
+  SpscRing<StreamSample> m_ring{ring_capacity};
+
+  std::atomic<StreamState> m_state{StreamState::Connecting};
+  std::atomic<bool> m_stopping{false};
+  std::atomic<std::uint64_t> m_bytes{0};
+  std::atomic<std::uint64_t> m_samples{0};
+  std::atomic<std::uint64_t> m_dropped{0};
+  std::atomic<std::uint64_t> m_blocked{0};
+  std::atomic<std::uint64_t> m_malformed{0};
+
+  // Only used by the reading thread
+  std::string m_line;
+  bool m_line_too_long{false};
+  std::vector<std::byte> m_record;
+  std::uint64_t m_next_index{0};
+  bool m_pending_notify{false};
+  std::chrono::steady_clock::time_point m_last_notify;
+
+  std::thread m_thread;
+};
+
+}  // namespace App::Plot
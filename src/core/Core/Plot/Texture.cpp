@@ -0,0 +1,63 @@
+#include "Texture.hpp"
+
+#include <SDL2/SDL.h>
+#include <imgui.h>
+
+#include <cstdint>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+
+namespace App::Plot {
+
+Texture::Texture(SDL_Renderer* renderer) : m_renderer(renderer) {}
+
+Texture::~Texture() {
+  reset();
+}
+
+void Texture::reset() {
+  if (m_texture != nullptr) {
+    SDL_DestroyTexture(m_texture);
+    m_texture = nullptr;
+  }
+  m_width = 0;
+  m_height = 0;
+}
+
+void Texture::upload(int width, int height, const std::uint32_t* pixels) {
+  APP_PROFILE_FUNCTION();
+
+  if (m_texture == nullptr || width != m_width || height != m_height) {
+    if (m_texture != nullptr) {
+      SDL_DestroyTexture(m_texture);
+    }
+
+    // ABGR8888 is IM_COL32's packing: red in the low byte
+    m_texture = SDL_CreateTexture(
+        m_renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (m_texture == nullptr) {
+      APP_ERROR("Error creating plot texture: {}", SDL_GetError());
+      m_width = 0;
+      m_height = 0;
+      return;
+    }
+
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(m_texture, SDL_ScaleModeLinear);
+    m_width = width;
+    m_height = height;
+  }
+
+  SDL_UpdateTexture(m_texture, nullptr, pixels, width * static_cast<int>(sizeof(std::uint32_t)));
+}
+
+ImTextureID Texture::id() const {
+  return static_cast<ImTextureID>(m_texture);
+}
+
+bool Texture::valid() const {
+  return m_texture != nullptr;
+}
+
+}  // namespace App::Plot
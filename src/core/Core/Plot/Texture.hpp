@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <imgui.h>
+
+#include <cstdint>
+
+namespace App::Plot {
+
+// An RGBA texture owned by the plot code and drawn through ImGui. Pixels use IM_COL32's
+// packing. The SDL texture is only recreated when the size changes.
+class Texture {
+ public:
+  explicit Texture(SDL_Renderer* renderer);
+  ~Texture();
+
+  Texture(const Texture&) = delete;
+  Texture(Texture&&) = delete;
+  Texture& operator=(Texture other) = delete;
+  Texture& operator=(Texture&& other) = delete;
+
+  void upload(int width, int height, const std::uint32_t* pixels);
+  // Destroys the texture, e.g. after the renderer lost it; the next upload creates it anew.
+  void reset();
+
+  [[nodiscard]] ImTextureID id() const;
+  [[nodiscard]] bool valid() const;
+
+ private:
+  SDL_Renderer* m_renderer{nullptr};
+  SDL_Texture* m_texture{nullptr};
+  int m_width{0};
+  int m_height{0};
+};
+
+}  // namespace App::Plot
@@ -0,0 +1,83 @@
+#include "TileCache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace App::Plot {
+
+namespace {
+
+void combine(std::size_t& seed, std::uint64_t value) {
+  // boost::hash_combine with a 64-bit constant
+  seed ^= static_cast<std::size_t>(value) + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+}
+
+}  // namespace
+
+std::size_t TileKeyHash::operator()(const TileKey& key) const {
+  std::size_t seed = key.kind;
+  combine(seed, key.revision);
+  combine(seed, key.level);
+  combine(seed, key.bound);
+  combine(seed, static_cast<std::uint64_t>(key.column));
+  combine(seed, static_cast<std::uint64_t>(key.row));
+  return seed;
+}
+
+std::size_t Tile::bytes() const {
+  return sizeof(Tile) + samples.points.capacity() * sizeof(ImVec2) +
+         samples.ends.capacity() * sizeof(std::uint32_t) +
+         region.pixels.capacity() * sizeof(std::uint32_t);
+}
+
+TileCache::TileCache(std::size_t capacity) : m_capacity(capacity) {}
+
+const Tile* TileCache::find(const TileKey& key) {
+  const auto found = m_index.find(key);
+  if (found == m_index.end()) {
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, found->second);
+  return &found->second->second;
+}
+
+const Tile& TileCache::insert(const TileKey& key, Tile&& tile) {
+  if (const auto found = m_index.find(key); found != m_index.end()) {
+    m_bytes -= found->second->second.bytes();
+    m_entries.erase(found->second);
+    m_index.erase(found);
+  }
+
+  m_bytes += tile.bytes();
+  m_entries.emplace_front(key, std::move(tile));
+  m_index.emplace(key, m_entries.begin());
+
+  evict();
+  return m_entries.front().second;
+}
+
+void TileCache::clear() {
+  m_entries.clear();
+  m_index.clear();
+  m_bytes = 0;
+}
+
+void TileCache::set_capacity(std::size_t capacity) {
+  m_capacity = capacity;
+  evict();
+}
+
+// The newest tile is kept even when it alone exceeds the capacity, so the tile just
+// inserted can always be used
+void TileCache::evict() {
+  while (m_bytes > m_capacity && m_entries.size() > 1) {
+    const Entry& oldest = m_entries.back();
+    m_bytes -= oldest.second.bytes();
+    m_index.erase(oldest.first);
+    m_entries.pop_back();
+  }
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/RegionMask.hpp"
+
+namespace App::Plot {
+
+// Identifies the samples of one square world-space tile. `level` tells apart tiles of the
+// same position sampled at different densities (the sample spacing's bit pattern), `kind`
+// the sampling method and `bound` any other setting the samples depend on, e.g. the bit
+// pattern of the y range explicit curves are clipped to.
+struct TileKey {
+  std::uint64_t revision{0};
+  std::uint64_t level{0};
+  std::uint64_t bound{0};
+  std::int64_t column{0};
+  std::int64_t row{0};
+  std::uint8_t kind{0};
+
+  [[nodiscard]] bool operator==(const TileKey& other) const = default;
+};
+
+struct TileKeyHash {
+  [[nodiscard]] std::size_t operator()(const TileKey& key) const;
+};
+
+// Curve pieces or region coverage of one tile.
+struct Tile {
+  Polylines samples;
+  RegionMask region;
+
+  [[nodiscard]] std::size_t bytes() const;
+};
+
+// Least recently used tiles, bounded by the memory their samples take. Lookups mark a
+// tile as used; inserting evicts from the other end until the cache fits its capacity
+// again. A pointer returned by `find` stays valid until the next `insert`.
+class TileCache {
+ public:
+  static constexpr std::size_t default_capacity = std::size_t{128} << 20U;
+
+  explicit TileCache(std::size_t capacity = default_capacity);
+
+  [[nodiscard]] const Tile* find(const TileKey& key);
+  const Tile& insert(const TileKey& key, Tile&& tile);
+  void clear();
+
+  void set_capacity(std::size_t capacity);
+  [[nodiscard]] std::size_t capacity() const {
+    return m_capacity;
+  }
+  [[nodiscard]] std::size_t bytes() const {
+    return m_bytes;
+  }
+  [[nodiscard]] std::size_t size() const {
+    return m_entries.size();
+  }
+
+ private:
+  void evict();
+
+  using Entry = std::pair<TileKey, Tile>;
+
+  // Most recently used first
+  std::list<Entry> m_entries;
+  std::unordered_map<TileKey, std::list<Entry>::iterator, TileKeyHash> m_index;
+  std::size_t m_capacity;
+  std::size_t m_bytes{0};
+};
+
+}  // namespace App::Plot
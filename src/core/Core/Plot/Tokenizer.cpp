@@ -0,0 +1,95 @@
+#include "Tokenizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace App::Plot {
+
+namespace {
+
+bool is_identifier_start(char c) {
+  return std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_' ||
+         static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool is_identifier_char(char c) {
+  return is_identifier_start(c) || std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+}  // namespace
+
+Token Tokenizer::next() {
+  while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])) != 0) {
+    ++m_pos;
+  }
+  if (m_pos >= m_text.size()) {
+    return {TokenKind::End, {}, 0.0, m_text.size()};
+  }
+
+  const std::size_t start = m_pos;
+  const char c = m_text[m_pos];
+
+  if (std::isdigit(static_cast<unsigned char>(c)) != 0 || c == '.') {
+    return number(start);
+  }
+  if (is_identifier_start(c)) {
+    while (m_pos < m_text.size() && is_identifier_char(m_text[m_pos])) {
+      ++m_pos;
+    }
+    return {TokenKind::Identifier, m_text.substr(start, m_pos - start), 0.0, start};
+  }
+
+  static constexpr std::array<std::string_view, 6> two_char{"<=", ">=", "==", "!=", "<>", "**"};
+  if (m_pos + 1 < m_text.size()) {
+    const std::string_view pair = m_text.substr(m_pos, 2);
+    if (std::find(two_char.begin(), two_char.end(), pair) != two_char.end()) {
+      m_pos += 2;
+      return {TokenKind::Symbol, pair, 0.0, start};
+    }
+  }
+  ++m_pos;
+  if (std::string_view{"+-*/%^<>=()[]{},&|"}.find(c) != std::string_view::npos) {
+    return {TokenKind::Symbol, m_text.substr(start, 1), 0.0, start};
+  }
+  return {TokenKind::Invalid, m_text.substr(start, 1), 0.0, start};
+}
+
+Token Tokenizer::number(std::size_t start) {
+  const auto digits = [this] {
+    while (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos])) != 0) {
+      ++m_pos;
+    }
+  };
+  digits();
+  if (m_pos < m_text.size() && m_text[m_pos] == '.') {
+    ++m_pos;
+    digits();
+  }
+  // An exponent needs digits, otherwise "2e" is 2 * e
+  if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+    std::size_t exponent = m_pos + 1;
+    if (exponent < m_text.size() && (m_text[exponent] == '+' || m_text[exponent] == '-')) {
+      ++exponent;
+    }
+    if (exponent < m_text.size() &&
+        std::isdigit(static_cast<unsigned char>(m_text[exponent])) != 0) {
+      m_pos = exponent;
+      digits();
+    }
+  }
+
+  const std::string literal{m_text.substr(start, m_pos - start)};
+  char* end = nullptr;
+  const double value = std::strtod(literal.c_str(), &end);
+  if (end != literal.c_str() + literal.size()) {
+    return {TokenKind::Invalid, m_text.substr(start, m_pos - start), 0.0, start};
+  }
+  return {TokenKind::Number, m_text.substr(start, m_pos - start), value, start};
+}
+
+}  // namespace App::Plot
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace App::Plot {
+
+enum class TokenKind : std::uint8_t { Number, Identifier, Symbol, End, Invalid };
+
+struct Token {
+  TokenKind kind{TokenKind::End};
+  // A view into the tokenized text
+  std::string_view text;
+  double number{0.0};
+  // Position of the token in the text
+  std::size_t offset{0};
+};
+
+// Splits expression text into exprtk's numbers, identifiers and operator symbols. A
+// character that starts none of them is returned as a single Invalid token, so scanning
+// can go on past syntax only exprtk understands.
+class Tokenizer {
+ public:
+  explicit Tokenizer(std::string_view text) : m_text(text) {}
+
+  Token next();
+
+ private:
+  Token number(std::size_t start);
+
+  std::string_view m_text;
+  std::size_t m_pos{0};
+};
+
+}  // namespace App::Plot
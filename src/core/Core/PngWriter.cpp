@@ -0,0 +1,234 @@
+#include "PngWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+
+namespace App {
+
+namespace {
+
+constexpr std::array<std::uint8_t, 8> signature{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+constexpr std::array<std::uint32_t, 256> crc_table = [] {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t n = 0; n < table.size(); ++n) {
+    std::uint32_t c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1U) != 0 ? 0xEDB88320U ^ (c >> 1U) : c >> 1U;
+    }
+    table[n] = c;
+  }
+  return table;
+}();
+
+std::uint32_t crc32(std::span<const std::uint8_t> bytes, std::uint32_t crc = 0) {
+  crc = ~crc;
+  for (const std::uint8_t byte : bytes) {
+    crc = crc_table[(crc ^ byte) & 0xFFU] ^ (crc >> 8U);
+  }
+  return ~crc;
+}
+
+void put_u32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+  out.push_back(static_cast<std::uint8_t>(value >> 24U));
+  out.push_back(static_cast<std::uint8_t>(value >> 16U));
+  out.push_back(static_cast<std::uint8_t>(value >> 8U));
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void put_chunk(std::vector<std::uint8_t>& out,
+    std::string_view type,
+    std::span<const std::uint8_t> data) {
+  put_u32(out, static_cast<std::uint32_t>(data.size()));
+  const std::size_t type_start = out.size();
+  out.insert(out.end(), type.begin(), type.end());
+  out.insert(out.end(), data.begin(), data.end());
+  put_u32(out, crc32(std::span(out).subspan(type_start)));
+}
+
+// Deflate bit stream: values are packed starting at the least significant bit, Huffman
+// codes most significant bit first.
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+  void put(std::uint32_t value, unsigned count) {
+    m_buffer |= static_cast<std::uint64_t>(value) << m_count;
+    m_count += count;
+    while (m_count >= 8) {
+      m_out.push_back(static_cast<std::uint8_t>(m_buffer));
+      m_buffer >>= 8U;
+      m_count -= 8;
+    }
+  }
+
+  void put_code(std::uint32_t code, unsigned length) {
+    std::uint32_t reversed = 0;
+    for (unsigned i = 0; i < length; ++i) {
+      reversed = (reversed << 1U) | ((code >> i) & 1U);
+    }
+    put(reversed, length);
+  }
+
+  void flush() {
+    if (m_count > 0) {
+      m_out.push_back(static_cast<std::uint8_t>(m_buffer));
+    }
+    m_buffer = 0;
+    m_count = 0;
+  }
+
+ private:
+  std::vector<std::uint8_t>& m_out;
+  std::uint64_t m_buffer{0};
+  unsigned m_count{0};
+};
+
+// Fixed Huffman literal/length codes (RFC 1951, 3.2.6)
+void put_symbol(BitWriter& bits, std::uint32_t symbol) {
+  if (symbol < 144) {
+    bits.put_code(0x30U + symbol, 8);
+  } else if (symbol < 256) {
+    bits.put_code(0x190U + symbol - 144U, 9);
+  } else if (symbol < 280) {
+    bits.put_code(symbol - 256U, 7);
+  } else {
+    bits.put_code(0xC0U + symbol - 280U, 8);
+  }
+}
+
+constexpr std::array<std::uint16_t, 29> length_base{3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19,
+    23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<std::uint8_t, 29> length_extra{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::size_t min_match = 3;
+constexpr std::size_t max_match = 258;
+
+// Repeats the previous byte `length` more times: a match at distance 1.
+void put_run(BitWriter& bits, std::size_t length) {
+  std::size_t code = length_base.size() - 1;
+  while (length_base[code] > length) {
+    --code;
+  }
+  put_symbol(bits, static_cast<std::uint32_t>(257 + code));
+  bits.put(static_cast<std::uint32_t>(length - length_base[code]), length_extra[code]);
+  // Distance code 0 (distance 1), five bits without extra bits
+  bits.put_code(0, 5);
+}
+
+// Compresses `data` as one fixed Huffman block. `previous` is the byte preceding `data`
+// in the stream, if any, so runs can continue across calls.
+void deflate_runs(BitWriter& bits, std::span<const std::uint8_t> data, int& previous) {
+  std::size_t i = 0;
+  while (i < data.size()) {
+    if (previous == data[i]) {
+      std::size_t run = 1;
+      while (i + run < data.size() && run < max_match && data[i + run] == data[i]) {
+        ++run;
+      }
+      if (run >= min_match) {
+        put_run(bits, run);
+        i += run;
+        continue;
+      }
+    }
+
+    put_symbol(bits, data[i]);
+    previous = data[i];
+    ++i;
+  }
+}
+
+constexpr std::uint32_t adler_modulus = 65521;
+constexpr std::size_t adler_block = 5552;
+
+}  // namespace
+
+std::vector<std::uint8_t> PngWriter::encode(std::uint32_t width,
+    std::uint32_t height,
+    std::size_t stride,
+    std::span<const std::uint32_t> pixels) {
+  APP_PROFILE_FUNCTION();
+
+  std::vector<std::uint8_t> out(signature.begin(), signature.end());
+
+  std::vector<std::uint8_t> header;
+  put_u32(header, width);
+  put_u32(header, height);
+  // 8 bits per channel, RGBA, deflate, adaptive filtering, no interlacing
+  header.insert(header.end(), {8, 6, 0, 0, 0});
+  put_chunk(out, "IHDR", header);
+
+  std::vector<std::uint8_t> compressed{0x78, 0x01};
+  BitWriter bits(compressed);
+  // A single final block with fixed codes
+  bits.put(1, 1);
+  bits.put(1, 2);
+
+  std::uint32_t adler_a = 1;
+  std::uint32_t adler_b = 0;
+  int previous = -1;
+
+  const std::size_t row_bytes = static_cast<std::size_t>(width) * 4;
+  std::vector<std::uint8_t> row(1 + row_bytes);
+  for (std::uint32_t y = 0; y < height; ++y) {
+    const std::span<const std::uint32_t> source = pixels.subspan(y * stride, width);
+
+    // Sub filter: each byte minus the same channel of the pixel to its left
+    row[0] = 1;
+    std::uint32_t left = 0;
+    for (std::size_t x = 0; x < width; ++x) {
+      const std::uint32_t pixel = source[x];
+      for (unsigned channel = 0; channel < 4; ++channel) {
+        const unsigned shift = channel * 8;
+        row[1 + x * 4 + channel] =
+            static_cast<std::uint8_t>((pixel >> shift) - (left >> shift));
+      }
+      left = pixel;
+    }
+
+    // The sums cannot overflow within adler_block bytes, so reduce once per block
+    for (std::size_t start = 0; start < row.size(); start += adler_block) {
+      const std::size_t end = std::min(row.size(), start + adler_block);
+      for (std::size_t i = start; i < end; ++i) {
+        adler_a += row[i];
+        adler_b += adler_a;
+      }
+      adler_a %= adler_modulus;
+      adler_b %= adler_modulus;
+    }
+    deflate_runs(bits, row, previous);
+  }
+
+  put_symbol(bits, 256);
+  bits.flush();
+  put_u32(compressed, (adler_b << 16U) | adler_a);
+
+  put_chunk(out, "IDAT", compressed);
+  put_chunk(out, "IEND", {});
+  return out;
+}
+
+bool PngWriter::write(const std::filesystem::path& path,
+    std::uint32_t width,
+    std::uint32_t height,
+    std::size_t stride,
+    std::span<const std::uint32_t> pixels) {
+  APP_PROFILE_FUNCTION();
+
+  const std::vector<std::uint8_t> png = encode(width, height, stride, pixels);
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+  return file.good();
+}
+
+}  // namespace App
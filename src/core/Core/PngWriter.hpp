@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace App {
+
+// Minimal 8-bit RGBA PNG encoder for offscreen renders. Rows are Sub filtered and
+// compressed as runs of repeated bytes only, which is enough to shrink the large flat areas
+// of a plot to a fraction of their raw size without pulling in zlib.
+class PngWriter {
+ public:
+  // `pixels` holds `height` rows of `stride` pixels each, packed like IM_COL32 (red in the
+  // lowest byte).
+  [[nodiscard]] static std::vector<std::uint8_t> encode(std::uint32_t width,
+      std::uint32_t height,
+      std::size_t stride,
+      std::span<const std::uint32_t> pixels);
+
+  // Encodes and writes to `path`. Returns false when the file could not be written.
+  static bool write(const std::filesystem::path& path,
+      std::uint32_t width,
+      std::uint32_t height,
+      std::size_t stride,
+      std::span<const std::uint32_t> pixels);
+};
+
+}  // namespace App
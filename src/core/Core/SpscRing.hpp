@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace App {
+
+// Fixed-size ring written by one thread and read by one other thread. Neither side locks
+// or allocates; push fails when the ring is full and the producer decides whether the item
+// is dropped or retried later.
+template <typename T>
+class SpscRing {
+ public:
+  explicit SpscRing(std::size_t capacity) : m_items(capacity) {}
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing(SpscRing&&) = delete;
+  SpscRing& operator=(SpscRing other) = delete;
+  SpscRing& operator=(SpscRing&& other) = delete;
+  ~SpscRing() = default;
+
+  bool push(const T& item) {
+    const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= m_items.size()) {
+      return false;
+    }
+
+    m_items[head % m_items.size()] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Hands every item pushed so far to `sink` in order and frees their slots.
+  template <typename Sink>
+  std::size_t drain(Sink&& sink) {
+    const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+    for (std::uint64_t i = tail; i < head; ++i) {
+      sink(m_items[i % m_items.size()]);
+    }
+    m_tail.store(head, std::memory_order_release);
+    return static_cast<std::size_t>(head - tail);
+  }
+
+  // Items waiting to be drained; from any other thread only an estimate.
+  [[nodiscard]] std::size_t size() const {
+    return static_cast<std::size_t>(
+        m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire));
+  }
+  [[nodiscard]] std::size_t capacity() const {
+    return m_items.size();
+  }
+
+ private:
+  std::vector<T> m_items;
+  // Written by the producer, read by the consumer
+  alignas(64) std::atomic<std::uint64_t> m_head{0};
+  // Written by the consumer, read by the producer
+  alignas(64) std::atomic<std::uint64_t> m_tail{0};
+};
+
+}  // namespace App
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace App {
+
+enum class StreamEndpoint : std::uint8_t { Stdin, Fifo, UnixSocket };
+
+// A byte stream read by a background thread: the process's standard input, a named pipe
+// (a FIFO, or \\.\pipe\<name> on Windows) or a Unix domain socket served by another
+// process. Reads wait at most a given time, so the reading thread can be stopped.
+// Implemented per platform.
+class StreamConnection {
+ public:
+  // Logs the reason and stays invalid when the endpoint cannot be opened.
+  StreamConnection(StreamEndpoint endpoint, const std::filesystem::path& path);
+  ~StreamConnection();
+
+  StreamConnection(const StreamConnection&) = delete;
+  StreamConnection(StreamConnection&&) = delete;
+  StreamConnection& operator=(StreamConnection other) = delete;
+  StreamConnection& operator=(StreamConnection&& other) = delete;
+
+  [[nodiscard]] bool valid() const {
+    return m_valid;
+  }
+
+  // The number of bytes read into `buffer`, 0 when none arrived within `timeout` and -1
+  // once the stream has ended. A FIFO never ends: a writer closing it just leaves it
+  // waiting for the next one.
+  std::ptrdiff_t read(std::span<std::byte> buffer, std::chrono::milliseconds timeout);
+
+ private:
+  StreamEndpoint m_endpoint;
+  // A file descriptor, or a HANDLE on Windows
+  std::intptr_t m_handle{-1};
+  bool m_valid{false};
+};
+
+}  // namespace App
@@ -0,0 +1,96 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace App {
+
+ThreadPool::ThreadPool(std::size_t size) {
+  // Worker 0 is whichever thread calls parallel_for
+  const std::size_t threads = std::max<std::size_t>(size, 1) - 1;
+  m_threads.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    m_threads.emplace_back([this, worker = i + 1] { work(worker); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+
+  for (std::thread& thread : m_threads) {
+    thread.join();
+  }
+}
+
+std::size_t ThreadPool::size() const {
+  return m_threads.size() + 1;
+}
+
+void ThreadPool::parallel_for(std::size_t count, const Task& task) {
+  if (count == 0) {
+    return;
+  }
+  if (m_threads.empty() || count == 1) {
+    for (std::size_t index = 0; index < count; ++index) {
+      task(index, 0);
+    }
+    return;
+  }
+
+  {
+    const std::lock_guard lock(m_mutex);
+    m_task = &task;
+    m_count = count;
+    m_next.store(0, std::memory_order_relaxed);
+    m_active = m_threads.size();
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  run_tasks(0);
+
+  std::unique_lock lock(m_mutex);
+  m_done.wait(lock, [this] { return m_active == 0; });
+  m_task = nullptr;
+}
+
+void ThreadPool::work(std::size_t worker) {
+  std::uint64_t seen_generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_wake.wait(lock, [this, seen_generation] {
+        return m_stopping || m_generation != seen_generation;
+      });
+      if (m_stopping) {
+        return;
+      }
+      seen_generation = m_generation;
+    }
+
+    run_tasks(worker);
+
+    {
+      const std::lock_guard lock(m_mutex);
+      --m_active;
+    }
+    m_done.notify_one();
+  }
+}
+
+void ThreadPool::run_tasks(std::size_t worker) {
+  // Indices are handed out one at a time so uneven tasks still balance
+  for (std::size_t index = m_next.fetch_add(1, std::memory_order_relaxed); index < m_count;
+       index = m_next.fetch_add(1, std::memory_order_relaxed)) {
+    (*m_task)(index, worker);
+  }
+}
+
+}  // namespace App
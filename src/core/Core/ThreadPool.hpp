@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace App {
+
+// A fixed set of worker threads for data-parallel loops. The thread calling
+// `parallel_for` takes part in the loop, so a pool of size 1 runs everything inline.
+// `parallel_for` must not be called from two threads at once or from inside a task.
+class ThreadPool {
+ public:
+  using Task = std::function<void(std::size_t index, std::size_t worker)>;
+
+  explicit ThreadPool(std::size_t size = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool other) = delete;
+  ThreadPool& operator=(ThreadPool&& other) = delete;
+
+  // Number of threads taking part in a loop, including the caller.
+  [[nodiscard]] std::size_t size() const;
+
+  // Runs task(index, worker) for every index in [0, count) and returns once all of them
+  // have finished. `worker` is in [0, size()) and is stable for the duration of a task, so
+  // it can select per-thread state; the caller is always worker 0.
+  void parallel_for(std::size_t count, const Task& task);
+
+ private:
+  void work(std::size_t worker);
+  void run_tasks(std::size_t worker);
+
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  std::uint64_t m_generation{0};
+  std::size_t m_active{0};
+  bool m_stopping{false};
+
+  const Task* m_task{nullptr};
+  std::size_t m_count{0};
+  std::atomic<std::size_t> m_next{0};
+};
+
+}  // namespace App
@@ -0,0 +1,13 @@
+#include "Platform/Posix/LastError.hpp"
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+
+namespace App::Posix {
+
+std::string last_error() {
+  return std::error_code(errno, std::generic_category()).message();
+}
+
+}  // namespace App::Posix
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace App::Posix {
+
+// The message for the current errno. Take it before logging, which may change errno.
+std::string last_error();
+
+}  // namespace App::Posix
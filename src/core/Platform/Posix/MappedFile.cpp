@@ -0,0 +1,64 @@
+#include "Core/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+#include "Platform/Posix/LastError.hpp"
+
+namespace App {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+  APP_PROFILE_FUNCTION();
+
+  const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Could not open {}: {}", path.string(), reason);
+    return;
+  }
+
+  struct stat status {};
+  if (::fstat(descriptor, &status) != 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Could not read the size of {}: {}", path.string(), reason);
+    ::close(descriptor);
+    return;
+  }
+
+  // mmap refuses empty mappings, an empty file is just an empty view
+  const auto size = static_cast<std::size_t>(status.st_size);
+  if (size > 0) {
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (data == MAP_FAILED) {
+      const std::string reason = Posix::last_error();
+      APP_ERROR("Could not map {}: {}", path.string(), reason);
+      ::close(descriptor);
+      return;
+    }
+    m_data = data;
+    m_size = size;
+  }
+
+  // The mapping keeps the file referenced on its own
+  ::close(descriptor);
+  m_valid = true;
+}
+
+MappedFile::~MappedFile() {
+  APP_PROFILE_FUNCTION();
+
+  if (m_data != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<void*>(m_data), m_size);
+  }
+}
+
+}  // namespace App
@@ -0,0 +1,127 @@
+#include "Core/StreamConnection.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <thread>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+#include "Platform/Posix/LastError.hpp"
+
+namespace App {
+
+namespace {
+
+int connect_socket(const std::filesystem::path& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string name = path.string();
+  if (name.size() >= sizeof(address.sun_path)) {
+    APP_ERROR("Socket path {} is longer than {} bytes", name, sizeof(address.sun_path) - 1);
+    return -1;
+  }
+  std::memcpy(static_cast<char*>(address.sun_path), name.c_str(), name.size() + 1);
+
+  const int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (descriptor < 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Could not create a socket: {}", reason);
+    return -1;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (::connect(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Could not connect to {}: {}", name, reason);
+    ::close(descriptor);
+    return -1;
+  }
+  return descriptor;
+}
+
+}  // namespace
+
+StreamConnection::StreamConnection(StreamEndpoint endpoint, const std::filesystem::path& path)
+    : m_endpoint(endpoint) {
+  APP_PROFILE_FUNCTION();
+
+  int descriptor = -1;
+  switch (endpoint) {
+    case StreamEndpoint::Stdin:
+      descriptor = STDIN_FILENO;
+      break;
+    case StreamEndpoint::Fifo:
+      // Without O_NONBLOCK opening would wait for a writer, which could not be cancelled
+      descriptor = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+      if (descriptor < 0) {
+        const std::string reason = Posix::last_error();
+        APP_ERROR("Could not open {}: {}", path.string(), reason);
+      }
+      break;
+    case StreamEndpoint::UnixSocket:
+      descriptor = connect_socket(path);
+      break;
+  }
+
+  m_handle = descriptor;
+  m_valid = descriptor >= 0;
+}
+
+StreamConnection::~StreamConnection() {
+  APP_PROFILE_FUNCTION();
+
+  // Standard input belongs to the process
+  if (m_valid && m_endpoint != StreamEndpoint::Stdin) {
+    ::close(static_cast<int>(m_handle));
+  }
+}
+
+std::ptrdiff_t StreamConnection::read(std::span<std::byte> buffer,
+    std::chrono::milliseconds timeout) {
+  if (!m_valid) {
+    return -1;
+  }
+
+  const auto descriptor = static_cast<int>(m_handle);
+  pollfd request{descriptor, POLLIN, 0};
+  const int ready = ::poll(&request, 1, static_cast<int>(timeout.count()));
+  if (ready == 0 || (ready < 0 && errno == EINTR)) {
+    return 0;
+  }
+  if (ready < 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Waiting for stream data failed: {}", reason);
+    return -1;
+  }
+
+  const ssize_t count = ::read(descriptor, buffer.data(), buffer.size());
+  if (count > 0) {
+    return count;
+  }
+  if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+    return 0;
+  }
+  if (count == 0 && m_endpoint == StreamEndpoint::Fifo) {
+    // No writer at the moment, poll reports that right away until one opens the FIFO
+    std::this_thread::sleep_for(timeout);
+    return 0;
+  }
+  if (count < 0) {
+    const std::string reason = Posix::last_error();
+    APP_ERROR("Reading the stream failed: {}", reason);
+  }
+  return -1;
+}
+
+}  // namespace App
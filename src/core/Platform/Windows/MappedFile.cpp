@@ -0,0 +1,68 @@
+#include "Core/MappedFile.hpp"
+
+#include <windows.h>
+
+#include <cstddef>
+#include <filesystem>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+
+namespace App {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+  APP_PROFILE_FUNCTION();
+
+  HANDLE file = CreateFileW(path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    APP_ERROR("Could not open {}: error {}", path.string(), GetLastError());
+    return;
+  }
+
+  LARGE_INTEGER size{};
+  if (GetFileSizeEx(file, &size) == 0) {
+    APP_ERROR("Could not read the size of {}: error {}", path.string(), GetLastError());
+    CloseHandle(file);
+    return;
+  }
+
+  // Empty files cannot be mapped, they are just an empty view
+  if (size.QuadPart > 0) {
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+      APP_ERROR("Could not map {}: error {}", path.string(), GetLastError());
+      CloseHandle(file);
+      return;
+    }
+
+    // The view keeps the mapping and the file referenced on its own
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+      APP_ERROR("Could not map {}: error {}", path.string(), GetLastError());
+      CloseHandle(file);
+      return;
+    }
+    m_data = data;
+    m_size = static_cast<std::size_t>(size.QuadPart);
+  }
+
+  CloseHandle(file);
+  m_valid = true;
+}
+
+MappedFile::~MappedFile() {
+  APP_PROFILE_FUNCTION();
+
+  if (m_data != nullptr) {
+    UnmapViewOfFile(m_data);
+  }
+}
+
+}  // namespace App
@@ -0,0 +1,87 @@
+#include "Core/StreamConnection.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <thread>
+
+#include "Core/Debug/Instrumentor.hpp"
+#include "Core/Log.hpp"
+
+namespace App {
+
+StreamConnection::StreamConnection(StreamEndpoint endpoint, const std::filesystem::path& path)
+    : m_endpoint(endpoint) {
+  APP_PROFILE_FUNCTION();
+
+  HANDLE handle = INVALID_HANDLE_VALUE;
+  switch (endpoint) {
+    case StreamEndpoint::Stdin:
+      handle = GetStdHandle(STD_INPUT_HANDLE);
+      // A console cannot be polled, and a blocking read of one could not be stopped
+      if (handle != INVALID_HANDLE_VALUE && handle != nullptr &&
+          GetFileType(handle) == FILE_TYPE_CHAR) {
+        APP_ERROR("Standard input is a console, pipe the samples into it instead");
+        handle = INVALID_HANDLE_VALUE;
+      }
+      break;
+    case StreamEndpoint::Fifo:
+      handle = CreateFileW(
+          path.c_str(), GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (handle == INVALID_HANDLE_VALUE) {
+        APP_ERROR("Could not open {}: error {}", path.string(), GetLastError());
+      }
+      break;
+    case StreamEndpoint::UnixSocket:
+      APP_ERROR("Unix domain sockets are not supported on Windows, use a named pipe instead");
+      break;
+  }
+
+  m_handle = reinterpret_cast<std::intptr_t>(handle);
+  m_valid = handle != INVALID_HANDLE_VALUE && handle != nullptr;
+}
+
+StreamConnection::~StreamConnection() {
+  APP_PROFILE_FUNCTION();
+
+  // Standard input belongs to the process
+  if (m_valid && m_endpoint != StreamEndpoint::Stdin) {
+    CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+  }
+}
+
+std::ptrdiff_t StreamConnection::read(std::span<std::byte> buffer,
+    std::chrono::milliseconds timeout) {
+  if (!m_valid) {
+    return -1;
+  }
+
+  auto* handle = reinterpret_cast<HANDLE>(m_handle);
+  DWORD size = static_cast<DWORD>(std::min<std::size_t>(buffer.size(), MAXDWORD));
+
+  // Pipes can be asked what is available without blocking; anything else, like a
+  // redirected file, is read directly
+  DWORD available = 0;
+  if (PeekNamedPipe(handle, nullptr, 0, nullptr, &available, nullptr) != 0) {
+    if (available == 0) {
+      std::this_thread::sleep_for(timeout);
+      return 0;
+    }
+    size = std::min(size, available);
+  } else if (GetLastError() == ERROR_BROKEN_PIPE) {
+    return -1;
+  }
+
+  DWORD count = 0;
+  if (ReadFile(handle, buffer.data(), size, &count, nullptr) == 0 || count == 0) {
+    return -1;
+  }
+  return static_cast<std::ptrdiff_t>(count);
+}
+
+}  // namespace App
@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "Core/Plot/AdaptiveSampler.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::Plot::AdaptiveSampler") {
+  TEST_CASE("Smooth curves stay within the per-pixel budget") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -5.0;
+    settings.x_max = 5.0;
+    settings.pixels_per_unit = 100.0;
+
+    App::Plot::Polylines out;
+    const std::size_t evaluations =
+        App::Plot::sample_explicit([](double x) { return std::sin(x); }, settings, out);
+
+    CHECK_EQ(out.strip_count(), 1U);
+    CHECK_LE(evaluations, 4001U);
+    CHECK_EQ(out.points.front().x, doctest::Approx(-5.0));
+    CHECK_EQ(out.points.back().x, doctest::Approx(5.0));
+  }
+
+  TEST_CASE("A batch function takes the initial samples and gives the same curve") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -3.0;
+    settings.x_max = 3.0;
+    settings.pixels_per_unit = 50.0;
+
+    const auto f = [](double x) { return std::tan(x); };
+    App::Plot::Polylines scalar;
+    const std::size_t scalar_evaluations = App::Plot::sample_explicit(f, settings, scalar);
+
+    std::size_t batched_points = 0;
+    const App::Plot::BatchFunction f_batch = [&](std::span<const double> xs,
+                                                 std::span<double> ys) {
+      REQUIRE_EQ(xs.size(), ys.size());
+      batched_points += xs.size();
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        ys[i] = f(xs[i]);
+      }
+    };
+    App::Plot::Polylines batched;
+    const std::size_t batched_evaluations =
+        App::Plot::sample_explicit(f, f_batch, settings, batched);
+
+    // 300 pixels at the initial spacing of 2
+    CHECK_EQ(batched_points, 151U);
+    CHECK_EQ(batched_evaluations, scalar_evaluations);
+    CHECK(batched.ends == scalar.ends);
+    REQUIRE_EQ(batched.points.size(), scalar.points.size());
+    for (std::size_t i = 0; i < scalar.points.size(); ++i) {
+      CHECK_EQ(batched.points[i].x, scalar.points[i].x);
+      CHECK_EQ(batched.points[i].y, scalar.points[i].y);
+    }
+  }
+
+  TEST_CASE("Poles split the curve") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -3.0;
+    settings.x_max = 3.0;
+    settings.pixels_per_unit = 50.0;
+
+    App::Plot::Polylines reciprocal;
+    App::Plot::sample_explicit([](double x) { return 1.0 / x; }, settings, reciprocal);
+    CHECK_EQ(reciprocal.strip_count(), 2U);
+
+    // tan has poles at +-pi/2 inside the range
+    App::Plot::Polylines tangent;
+    App::Plot::sample_explicit([](double x) { return std::tan(x); }, settings, tangent);
+    CHECK_EQ(tangent.strip_count(), 3U);
+  }
+
+  TEST_CASE("Checking jumps is charged to the per-pixel budget") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -500.0;
+    settings.x_max = 500.0;
+    settings.pixels_per_unit = 2.0;
+
+    // Hundreds of poles, a few pixels apart
+    App::Plot::Polylines tangent;
+    const std::size_t tangent_evaluations =
+        App::Plot::sample_explicit([](double x) { return std::tan(x); }, settings, tangent);
+    CHECK_LE(tangent_evaluations, 8000U);
+    CHECK_GT(tangent.strip_count(), 1U);
+
+    App::Plot::Polylines steep;
+    const std::size_t steep_evaluations =
+        App::Plot::sample_explicit([](double x) { return 1.0e4 * x * x * x; }, settings, steep);
+    CHECK_LE(steep_evaluations, 8000U);
+  }
+
+  TEST_CASE("Steep continuous curves are not split") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -1.0;
+    settings.x_max = 1.0;
+    settings.pixels_per_unit = 200.0;
+
+    App::Plot::Polylines out;
+    App::Plot::sample_explicit([](double x) { return 1.0e4 * x * x * x; }, settings, out);
+    CHECK_EQ(out.strip_count(), 1U);
+  }
+
+  TEST_CASE("Undefined regions are skipped") {
+    App::Plot::SamplerSettings settings;
+    settings.x_min = -2.0;
+    settings.x_max = 2.0;
+    settings.pixels_per_unit = 100.0;
+
+    App::Plot::Polylines out;
+    App::Plot::sample_explicit([](double x) { return std::sqrt(1.0 - x * x); }, settings, out);
+
+    REQUIRE_EQ(out.strip_count(), 1U);
+    for (const ImVec2& point : out.points) {
+      CHECK_LE(std::abs(point.x), 1.0F);
+    }
+    CHECK_LT(out.points.front().x, -0.99F);
+    CHECK_GT(out.points.back().x, 0.99F);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,84 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Core/Plot/BatchProgram.hpp"
+#include "Core/Plot/ExpressionTree.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+constexpr std::array<std::string_view, 2> XY{"x", "y"};
+
+// Compares the batch program against the tree's own scalar evaluation over more than
+// one block, the last one partial.
+void check_matches_tree(std::string_view text) {
+  CAPTURE(text);
+  const auto tree = App::Plot::ExpressionTree::parse(text, XY);
+  REQUIRE(tree.has_value());
+  const App::Plot::BatchProgram program = App::Plot::BatchProgram::compile(*tree);
+
+  const std::size_t count = 2 * App::Plot::BatchProgram::block_size + 37;
+  std::vector<double> xs(count);
+  std::vector<double> ys(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    xs[i] = -3.0 + 6.0 * static_cast<double>(i) / static_cast<double>(count);
+    ys[i] = 2.5 * std::sin(static_cast<double>(i));
+  }
+
+  std::vector<double> out(count);
+  App::Plot::BatchWorkspace workspace;
+  const std::array<const double*, 2> inputs{xs.data(), ys.data()};
+  program.evaluate(inputs, out, workspace);
+
+  std::vector<double> scratch;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::array<double, 2> point{xs[i], ys[i]};
+    const double expected = tree->evaluate(point, scratch);
+    if (std::isnan(expected)) {
+      CHECK(std::isnan(out[i]));
+    } else {
+      CHECK_EQ(out[i], doctest::Approx(expected));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::BatchProgram") {
+  TEST_CASE("Blocks match scalar evaluation") {
+    check_matches_tree("x^2 + y^2 - 4");
+    check_matches_tree("sin(x) * cos(y) - 0.2");
+    check_matches_tree("exp(-x^2) - log(abs(y) + 1) + sqrt(abs(x * y))");
+    check_matches_tree("y > x^3 - x and x < 1 or y < -2");
+    check_matches_tree("x^y + max(x, y) / min(x, 1)");
+    check_matches_tree("atan2(y, x) - hypot(x, y) + sgn(x) * floor(y)");
+    check_matches_tree("((x + 1) * (x - 1)) * ((y + 2) * (y - 2)) - (x + y) * (x - y)");
+  }
+
+  TEST_CASE("Registers are reused once consumed") {
+    // A left-leaning sum only ever needs one register
+    const auto tree = App::Plot::ExpressionTree::parse("sin(x) + cos(x) + tan(x) + exp(x)", XY);
+    REQUIRE(tree.has_value());
+    const App::Plot::BatchProgram program = App::Plot::BatchProgram::compile(*tree);
+    CHECK_LE(program.register_count(), 2U);
+  }
+
+  TEST_CASE("Bare variables and constants") {
+    for (const std::string_view text : {"x", "2 * pi"}) {
+      const auto tree = App::Plot::ExpressionTree::parse(text, XY);
+      REQUIRE(tree.has_value());
+      const App::Plot::BatchProgram program = App::Plot::BatchProgram::compile(*tree);
+      CHECK_EQ(program.instruction_count(), 0U);
+    }
+    check_matches_tree("x");
+    check_matches_tree("2 * pi");
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
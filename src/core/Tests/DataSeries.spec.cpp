@@ -0,0 +1,203 @@
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Core/Plot/DataSeries.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+// Removes the file and its pyramid when the test is done with them.
+struct TemporaryFile {
+  std::filesystem::path path;
+
+  explicit TemporaryFile(const std::string& name)
+      : path(std::filesystem::temp_directory_path() / name) {
+    remove();
+  }
+  ~TemporaryFile() {
+    remove();
+  }
+
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile(TemporaryFile&&) = delete;
+  TemporaryFile& operator=(TemporaryFile other) = delete;
+  TemporaryFile& operator=(TemporaryFile&& other) = delete;
+
+  void remove() const {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    std::filesystem::remove(App::Plot::DataSeries::pyramid_path(path), error);
+  }
+};
+
+void write_floats(const std::filesystem::path& path, const std::vector<float>& values) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(values.data()),
+      static_cast<std::streamsize>(values.size() * sizeof(float)));
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::DataSeries") {
+  TEST_CASE("Binary columns get a persisted min/max pyramid") {
+    const TemporaryFile file("DataSeriesTest.f32");
+    std::vector<float> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = std::sin(static_cast<float>(i) * 0.001F);
+    }
+    values[12345] = 7.0F;
+    values[54321] = -7.0F;
+    write_floats(file.path, values);
+
+    const App::Plot::DataSource source{file.path, App::Plot::DataSource::format_for(file.path)};
+    CHECK(source.format == App::Plot::DataFormat::Float32);
+
+    const auto series = App::Plot::DataSeries::load(source);
+    REQUIRE(series != nullptr);
+    CHECK_EQ(series->size(), values.size());
+    CHECK(std::filesystem::exists(App::Plot::DataSeries::pyramid_path(file.path)));
+
+    // 100000 samples need ceil(log8(100000)) levels up to a single bucket
+    REQUIRE_EQ(series->level_count(), 6U);
+    const auto top = series->level(series->level_count());
+    REQUIRE_EQ(top.size(), 1U);
+    CHECK_EQ(top[0].y_min, -7.0F);
+    CHECK_EQ(top[0].y_max, 7.0F);
+    CHECK_EQ(series->level(1).size(), 12500U);
+    CHECK_EQ(series->level(1)[12345 / 8].y_max, 7.0F);
+
+    // Loading again maps the persisted pyramid instead of rebuilding it
+    const auto reloaded = App::Plot::DataSeries::load(source);
+    REQUIRE(reloaded != nullptr);
+    CHECK_EQ(reloaded->level(3)[0].y_max, series->level(3)[0].y_max);
+    CHECK_EQ(reloaded->y(54321), -7.0);
+  }
+
+  TEST_CASE("The drawn level follows the window, not the series length") {
+    const TemporaryFile file("DataSeriesWindowTest.f32");
+    std::vector<float> values(1U << 20U);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i % 1000);
+    }
+    write_floats(file.path, values);
+
+    const auto series = App::Plot::DataSeries::load({file.path, App::Plot::DataFormat::Float32});
+    REQUIRE(series != nullptr);
+
+    // The whole series across 1000 pixels
+    App::Plot::DataWindow window;
+    window.x_min = 0.0;
+    window.x_max = static_cast<double>(values.size());
+    window.pixels = 1000.0;
+    App::Plot::Polylines out;
+    const std::size_t level = series->visible(window, out);
+    CHECK_EQ(level, 3U);
+    CHECK_LE(out.points.size(), 2U * 8U * 1000U);
+    CHECK_GE(out.points.size(), 2U * 1000U);
+
+    // A window narrower than the pixels draws the raw samples
+    window.x_min = 5000.0;
+    window.x_max = 5500.0;
+    out.clear();
+    CHECK_EQ(series->visible(window, out), 0U);
+    CHECK_EQ(out.points.size(), 503U);
+    CHECK_EQ(out.points[1].x, 5000.0F);
+
+    // The x mapping moves and stretches the series
+    window.x_offset = 100.0;
+    window.x_scale = 0.5;
+    window.x_min = 100.0;
+    window.x_max = 110.0;
+    out.clear();
+    series->visible(window, out);
+    CHECK_EQ(out.points.front().x, 100.0F);
+    CHECK_EQ(out.points.back().x, 110.5F);
+
+    // Nothing is visible left of the series
+    window.x_min = -50.0;
+    window.x_max = -10.0;
+    out.clear();
+    series->visible(window, out);
+    CHECK(out.points.empty());
+  }
+
+  TEST_CASE("CSV files with a header, gaps and an x column") {
+    const TemporaryFile file("DataSeriesTest.csv");
+    {
+      std::ofstream csv(file.path);
+      csv << "time,value\n# a comment\n0,1\n0.5,2\r\n1,\n2.5,-3\n4, 5\n";
+    }
+
+    const App::Plot::DataSource source{file.path, App::Plot::DataSource::format_for(file.path)};
+    const auto series = App::Plot::DataSeries::load(source);
+    REQUIRE(series != nullptr);
+    REQUIRE_EQ(series->size(), 5U);
+    CHECK_EQ(series->x(1), 0.5);
+    CHECK_EQ(series->y(1), 2.0);
+    CHECK(std::isnan(series->y(2)));
+    CHECK_EQ(series->x(4), 4.0);
+
+    // The missing value splits the curve
+    App::Plot::DataWindow window;
+    window.x_min = -1.0;
+    window.x_max = 5.0;
+    window.pixels = 600.0;
+    App::Plot::Polylines out;
+    series->visible(window, out);
+    CHECK_EQ(out.strip_count(), 2U);
+
+    // The parsed columns are persisted with the pyramid
+    const auto reloaded = App::Plot::DataSeries::load(source);
+    REQUIRE(reloaded != nullptr);
+    CHECK_EQ(reloaded->x(3), 2.5);
+    CHECK_EQ(reloaded->y(3), -3.0);
+  }
+
+  TEST_CASE("A changed file rebuilds its pyramid") {
+    const TemporaryFile file("DataSeriesChangeTest.csv");
+    {
+      std::ofstream csv(file.path);
+      csv << "1\n2\n3\n";
+    }
+    const App::Plot::DataSource source{file.path, App::Plot::DataFormat::Csv};
+    REQUIRE(App::Plot::DataSeries::load(source) != nullptr);
+
+    {
+      std::ofstream csv(file.path);
+      csv << "1\n2\n3\n4\n5\n";
+    }
+    const auto series = App::Plot::DataSeries::load(source);
+    REQUIRE(series != nullptr);
+    CHECK_EQ(series->size(), 5U);
+    CHECK_EQ(series->x(4), 4.0);
+  }
+
+  TEST_CASE("Invalid files are rejected") {
+    const TemporaryFile unsorted("DataSeriesUnsortedTest.csv");
+    {
+      std::ofstream csv(unsorted.path);
+      csv << "0,1\n2,1\n1,1\n";
+    }
+    CHECK(App::Plot::DataSeries::load({unsorted.path, App::Plot::DataFormat::Csv}) == nullptr);
+
+    const TemporaryFile truncated("DataSeriesTruncatedTest.f64");
+    write_floats(truncated.path, {1.0F, 2.0F, 3.0F});
+    CHECK(App::Plot::DataSeries::load({truncated.path, App::Plot::DataFormat::Float64}) ==
+          nullptr);
+
+    const TemporaryFile missing("DataSeriesMissingTest.csv");
+    CHECK(App::Plot::DataSeries::load({missing.path, App::Plot::DataFormat::Csv}) == nullptr);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,156 @@
+#include <doctest/doctest.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include "Core/Plot/Decimation.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+float lowest_y(const std::vector<ImVec2>& points) {
+  return std::min_element(points.begin(), points.end(), [](const ImVec2& a, const ImVec2& b) {
+    return a.y < b.y;
+  })->y;
+}
+
+float highest_y(const std::vector<ImVec2>& points) {
+  return std::max_element(points.begin(), points.end(), [](const ImVec2& a, const ImVec2& b) {
+    return a.y < b.y;
+  })->y;
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::Decimation") {
+  TEST_CASE("Column reduction keeps at most four points per pixel column") {
+    // 100 samples per pixel over 50 pixels
+    std::vector<ImVec2> strip;
+    for (int i = 0; i < 5000; ++i) {
+      const float x = 10.0F + static_cast<float>(i) * 0.01F;
+      strip.emplace_back(x, 100.0F + 40.0F * std::sin(x * 3.0F));
+    }
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> out;
+    const std::size_t count = decimator.reduce_columns(strip, out);
+
+    CHECK_EQ(count, out.size());
+    CHECK_LE(out.size(), 4U * 51U);
+    CHECK_EQ(out.front().x, strip.front().x);
+    CHECK_EQ(out.back().x, strip.back().x);
+    CHECK_EQ(lowest_y(out), lowest_y(strip));
+    CHECK_EQ(highest_y(out), highest_y(strip));
+    for (std::size_t i = 1; i < out.size(); ++i) {
+      CHECK_LE(out[i - 1].x, out[i].x);
+    }
+  }
+
+  TEST_CASE("Column reduction keeps spikes narrower than a pixel") {
+    std::vector<ImVec2> strip;
+    for (int i = 0; i < 100; ++i) {
+      strip.emplace_back(static_cast<float>(i) * 0.1F, i == 42 ? -500.0F : 0.0F);
+    }
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> out;
+    decimator.reduce_columns(strip, out);
+    CHECK_EQ(lowest_y(out), -500.0F);
+  }
+
+  TEST_CASE("Column reduction leaves sparse strips alone") {
+    const std::vector<ImVec2> strip{{0.5F, 1.0F}, {3.5F, 2.0F}, {7.5F, -1.0F}};
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> out{{-1.0F, -1.0F}};
+    CHECK_EQ(decimator.reduce_columns(strip, out), 3U);
+    REQUIRE_EQ(out.size(), 4U);
+    CHECK_EQ(out[1].x, 0.5F);
+    CHECK_EQ(out[3].y, -1.0F);
+  }
+
+  TEST_CASE("Simplification collapses straight runs") {
+    std::vector<ImVec2> strip;
+    for (int i = 0; i <= 1000; ++i) {
+      const float t = static_cast<float>(i);
+      // Wobbles by a tenth of a pixel around a diagonal
+      strip.emplace_back(t, 2.0F * t + (i % 2 == 0 ? 0.1F : -0.1F));
+    }
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> out;
+    CHECK_EQ(decimator.simplify(strip, 0.5F, out), 2U);
+    CHECK_EQ(out.front().x, strip.front().x);
+    CHECK_EQ(out.back().x, strip.back().x);
+  }
+
+  TEST_CASE("Simplified curves follow their on-screen length, not their sample count") {
+    const auto circle = [](float radius, int samples) {
+      std::vector<ImVec2> strip;
+      for (int i = 0; i <= samples; ++i) {
+        const float angle = 2.0F * std::numbers::pi_v<float> * static_cast<float>(i) /
+                            static_cast<float>(samples);
+        strip.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+      }
+      return strip;
+    };
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> coarse;
+    std::vector<ImVec2> fine;
+    decimator.simplify(circle(100.0F, 2000), 0.5F, coarse);
+    decimator.simplify(circle(100.0F, 20000), 0.5F, fine);
+
+    CHECK_LT(coarse.size(), 200U);
+    CHECK_LE(fine.size(), coarse.size() + coarse.size() / 4);
+
+    std::vector<ImVec2> small;
+    decimator.simplify(circle(10.0F, 20000), 0.5F, small);
+    CHECK_LT(small.size(), fine.size());
+
+    // A closed loop stays closed
+    CHECK_EQ(fine.front().x, doctest::Approx(fine.back().x));
+    CHECK_EQ(fine.front().y, doctest::Approx(fine.back().y).epsilon(1e-3));
+  }
+
+  TEST_CASE("Simplified points stay within the tolerance") {
+    std::vector<ImVec2> strip;
+    for (int i = 0; i <= 4000; ++i) {
+      const float t = static_cast<float>(i) * 0.005F;
+      strip.emplace_back(t * 20.0F * std::cos(t), t * 20.0F * std::sin(t));
+    }
+
+    App::Plot::PolylineDecimator decimator;
+    std::vector<ImVec2> out;
+    decimator.simplify(strip, 0.5F, out);
+    CHECK_LT(out.size(), strip.size() / 4);
+
+    // Every sample lies within the tolerance of some kept segment
+    std::size_t segment = 0;
+    for (const ImVec2& point : strip) {
+      while (segment + 1 < out.size() && point.x == out[segment + 1].x &&
+             point.y == out[segment + 1].y) {
+        ++segment;
+      }
+      if (segment + 1 >= out.size()) {
+        break;
+      }
+      const ImVec2 a = out[segment];
+      const ImVec2 b = out[segment + 1];
+      const float dx = b.x - a.x;
+      const float dy = b.y - a.y;
+      const float t =
+          std::clamp(((point.x - a.x) * dx + (point.y - a.y) * dy) / (dx * dx + dy * dy),
+              0.0F,
+              1.0F);
+      CHECK_LE(std::hypot(point.x - (a.x + t * dx), point.y - (a.y + t * dy)), 0.5F + 1e-3F);
+    }
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,107 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Core/Plot/BatchProgram.hpp"
+#include "Core/Plot/ExpressionCache.hpp"
+#include "Core/Plot/PlotDescription.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+double value_at(App::Plot::CompiledPlot& plot, double x) {
+  plot.x = x;
+  return plot.primary.value();
+}
+
+double batch_value_at(const App::Plot::CompiledPlot& plot, double x) {
+  REQUIRE(plot.primary_batch.has_value());
+  const std::array<const double*, 1> inputs{&x};
+  std::array<double, 1> out{};
+  App::Plot::BatchWorkspace workspace;
+  plot.primary_batch->evaluate(inputs, out, workspace);
+  return out[0];
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::ExpressionCache") {
+  TEST_CASE("Only a new text is compiled again") {
+    App::Plot::ExpressionCache cache;
+
+    App::Plot::CompiledPlot& first = cache.get("x^2");
+    CHECK_EQ(first.mode, App::Plot::PlotMode::Explicit);
+    const std::uint64_t revision = cache.revision();
+    const std::uint64_t compiled_revision = cache.compiled_revision();
+
+    CHECK_EQ(&cache.get("x^2"), &first);
+    CHECK_EQ(cache.revision(), revision);
+    CHECK_EQ(cache.compiled_revision(), compiled_revision);
+
+    App::Plot::CompiledPlot& second = cache.get("(cos(t), sin(t))");
+    CHECK_EQ(second.mode, App::Plot::PlotMode::Parametric);
+    CHECK_GT(cache.revision(), revision);
+    CHECK_GT(cache.compiled_revision(), compiled_revision);
+
+    // Text that does not compile leaves a plot that draws nothing
+    CHECK_EQ(cache.get("sin(").mode, App::Plot::PlotMode::None);
+  }
+
+  TEST_CASE("New parameter values are bound without compiling again") {
+    App::Plot::ExpressionCache cache;
+    App::Plot::CompiledPlot& plot = cache.get("a*x + b");
+    REQUIRE_EQ(cache.description().parameters.size(), 2U);
+    CHECK_EQ(value_at(plot, 2.0), doctest::Approx(3.0));
+    CHECK_EQ(batch_value_at(plot, 2.0), doctest::Approx(3.0));
+
+    const std::uint64_t revision = cache.revision();
+    const std::uint64_t compiled_revision = cache.compiled_revision();
+    const std::array<double, 2> values{2.0, 5.0};
+    cache.set_parameters(values);
+
+    // The same plot, with exprtk reading the new values in place and the batch form bound
+    // to them again
+    CHECK_EQ(&cache.current(), &plot);
+    CHECK_GT(cache.revision(), revision);
+    CHECK_EQ(cache.compiled_revision(), compiled_revision);
+    CHECK_EQ(value_at(plot, 2.0), doctest::Approx(9.0));
+    CHECK_EQ(batch_value_at(plot, 2.0), doctest::Approx(9.0));
+
+    // Unchanged values, or values for another number of parameters, change nothing
+    const std::uint64_t bound_revision = cache.revision();
+    cache.set_parameters(values);
+    const std::array<double, 1> other{7.0};
+    cache.set_parameters(other);
+    CHECK_EQ(cache.revision(), bound_revision);
+    CHECK_EQ(value_at(plot, 2.0), doctest::Approx(9.0));
+  }
+
+  TEST_CASE("Instances are separate copies that follow the parameters") {
+    App::Plot::ExpressionCache cache;
+    cache.get("a*x");
+
+    const std::span<App::Plot::CompiledPlot* const> instances = cache.instances(3);
+    REQUIRE_EQ(instances.size(), 3U);
+    CHECK_EQ(instances[0], &cache.current());
+    CHECK_NE(instances[1], instances[0]);
+    CHECK_NE(instances[2], instances[1]);
+
+    const std::array<double, 1> values{4.0};
+    cache.set_parameters(values);
+    for (App::Plot::CompiledPlot* instance : instances) {
+      CHECK_EQ(value_at(*instance, 0.5), doctest::Approx(2.0));
+    }
+
+    // A variable of one instance is not seen by the others
+    instances[1]->x = 10.0;
+    CHECK_EQ(instances[2]->primary.value(), doctest::Approx(4.0 * instances[2]->x));
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
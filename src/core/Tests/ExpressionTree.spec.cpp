@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <string_view>
+#include <vector>
+
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/Interval.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+constexpr std::array<std::string_view, 2> XY{"x", "y"};
+// x followed by two parameters
+constexpr std::array<std::string_view, 3> XAB{"x", "a", "b"};
+
+double evaluate(std::string_view text, double x, double y) {
+  const auto tree = App::Plot::ExpressionTree::parse(text, XY);
+  REQUIRE(tree.has_value());
+  std::vector<double> scratch;
+  const std::array<double, 2> variables{x, y};
+  return tree->evaluate(variables, scratch);
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::ExpressionTree") {
+  TEST_CASE("Precedence and implicit multiplication") {
+    CHECK_EQ(evaluate("1 + 2 * 3", 0, 0), doctest::Approx(7.0));
+    CHECK_EQ(evaluate("-x^2", 3, 0), doctest::Approx(-9.0));
+    CHECK_EQ(evaluate("2^3^2", 0, 0), doctest::Approx(512.0));
+    CHECK_EQ(evaluate("2x + 3(y - 1)", 2, 2), doctest::Approx(7.0));
+    CHECK_EQ(evaluate("(x + 1)(x - 1)", 3, 0), doctest::Approx(8.0));
+    CHECK_EQ(evaluate("2e", 0, 0), doctest::Approx(2.0 * std::exp(1.0)));
+    CHECK_EQ(evaluate("1.5e2", 0, 0), doctest::Approx(150.0));
+  }
+
+  TEST_CASE("Functions, constants and comparisons") {
+    CHECK_EQ(evaluate("sin(pi / 2) + max(x, y)", 1, 4), doctest::Approx(5.0));
+    CHECK_EQ(evaluate("SQRT(x*x + y*y)", 3, 4), doctest::Approx(5.0));
+    CHECK_EQ(evaluate("y > x and x >= 0", 1, 2), doctest::Approx(1.0));
+    CHECK_EQ(evaluate("y < x or x < 0", 1, 2), doctest::Approx(0.0));
+    CHECK_EQ(evaluate("ln(x) - log(y)", 2, 3), doctest::Approx(std::log(2.0 / 3.0)));
+    CHECK_EQ(evaluate("γ + φ", 0, 0), doctest::Approx(std::numbers::egamma + std::numbers::phi));
+  }
+
+  TEST_CASE("Constant sub-expressions are folded") {
+    const auto tree = App::Plot::ExpressionTree::parse("x * (2 + 3) + sin(0)", XY);
+    REQUIRE(tree.has_value());
+    CHECK_EQ(tree->nodes().size(), 5U);
+    CHECK(tree->uses_variable(0));
+    CHECK_FALSE(tree->uses_variable(1));
+  }
+
+  TEST_CASE("Bound parameters are folded with the constants") {
+    const auto tree = App::Plot::ExpressionTree::parse("x * (a + b) + sin(a)", XAB);
+    REQUIRE(tree.has_value());
+
+    const std::array<double, 2> parameters{2.0, 3.0};
+    const App::Plot::ExpressionTree bound = tree->bind(parameters);
+    CHECK_EQ(bound.variable_count(), 1U);
+    CHECK_EQ(bound.nodes().size(), 5U);
+
+    std::vector<double> scratch;
+    const std::array<double, 1> x{4.0};
+    CHECK_EQ(bound.evaluate(x, scratch), doctest::Approx(4.0 * 5.0 + std::sin(2.0)));
+  }
+
+  TEST_CASE("Splitting moves the parts without parameters into invariants") {
+    const auto tree = App::Plot::ExpressionTree::parse("a * sin(x) + cos(x)^2 * b + x", XAB);
+    REQUIRE(tree.has_value());
+
+    const App::Plot::SplitTree split = tree->split(2);
+    REQUIRE_EQ(split.invariants.size(), 2U);
+    CHECK_EQ(split.residual.variable_count(), 5U);
+
+    std::vector<double> scratch;
+    const double x = 0.7;
+    const double a = -1.5;
+    const double b = 2.5;
+    const std::array<double, 1> leading{x};
+    const double first = split.invariants[0].evaluate(leading, scratch);
+    const double second = split.invariants[1].evaluate(leading, scratch);
+    CHECK_EQ(first, doctest::Approx(std::sin(x)));
+    CHECK_EQ(second, doctest::Approx(std::cos(x) * std::cos(x)));
+
+    const std::array<double, 5> residual{x, first, second, a, b};
+    const std::array<double, 3> original{x, a, b};
+    CHECK_EQ(split.residual.evaluate(residual, scratch),
+        doctest::Approx(tree->evaluate(original, scratch)));
+
+    // Nothing to split off when every operation reads a parameter
+    CHECK(tree->bind(std::array<double, 2>{a, b}).split(0).invariants.empty());
+    const auto direct = App::Plot::ExpressionTree::parse("a * x + b", XAB);
+    REQUIRE(direct.has_value());
+    CHECK(direct->split(2).invariants.empty());
+  }
+
+  TEST_CASE("Unsupported syntax is rejected") {
+    CHECK_FALSE(App::Plot::ExpressionTree::parse("x := 2", XY).has_value());
+    CHECK_FALSE(App::Plot::ExpressionTree::parse("z + 1", XY).has_value());
+    CHECK_FALSE(App::Plot::ExpressionTree::parse("sin(x", XY).has_value());
+    CHECK_FALSE(App::Plot::ExpressionTree::parse("if (x > 0) 1; else 2;", XY).has_value());
+  }
+
+  TEST_CASE("Interval bounds enclose every point value") {
+    const std::array<std::string_view, 4> expressions{
+        "x^2 + y^2 - 1", "sin(3x) * cos(y) - y / 2", "exp(x) - log(y + 3) * x", "tan(x) - y"};
+    const App::Plot::Interval x_range{-1.3, 0.7};
+    const App::Plot::Interval y_range{0.2, 1.1};
+
+    for (const std::string_view text : expressions) {
+      const auto tree = App::Plot::ExpressionTree::parse(text, XY);
+      REQUIRE(tree.has_value());
+
+      std::vector<App::Plot::Interval> interval_scratch;
+      const std::array<App::Plot::Interval, 2> box{x_range, y_range};
+      const App::Plot::Interval bound = tree->evaluate(box, interval_scratch);
+
+      std::vector<double> scratch;
+      for (int i = 0; i <= 20; ++i) {
+        for (int j = 0; j <= 20; ++j) {
+          const std::array<double, 2> point{x_range.lo + (x_range.hi - x_range.lo) * i / 20.0,
+              y_range.lo + (y_range.hi - y_range.lo) * j / 20.0};
+          CHECK(bound.contains(tree->evaluate(point, scratch)));
+        }
+      }
+    }
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,171 @@
+#include <doctest/doctest.h>
+#include <imgui.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Core/Debug/Allocations.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/Plot/Decimation.hpp"
+#include "Core/Plot/PlotEvaluator.hpp"
+#include "Core/Plot/PlotLayer.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+// What a layer does with its scratch in one frame: screen points of a strip, decimated
+std::size_t draw_frame(App::FrameArena& arena,
+    App::Plot::PolylineDecimator& decimator,
+    const std::vector<ImVec2>& strip) {
+  arena.reset();
+  const App::ArenaAllocator<ImVec2> allocator(arena);
+  App::ArenaVector<ImVec2> screen_points(allocator);
+  App::ArenaVector<ImVec2> decimated_points(allocator);
+  screen_points.reserve(strip.size());
+  decimated_points.reserve(strip.size());
+
+  for (const ImVec2& point : strip) {
+    screen_points.emplace_back(point.x * 0.25F, point.y);
+  }
+  return decimator.reduce_columns(screen_points, decimated_points) +
+         decimator.simplify(screen_points, 0.5F, decimated_points);
+}
+
+// What the application does for an expression layer every frame: submit the layer's
+// text and view, pick up a completed result and draw it with the frame's scratch
+bool plot_frame(App::Plot::PlotEvaluator& evaluator,
+    App::Plot::PlotLayer& layer,
+    std::string_view text,
+    const App::Plot::PlotView& view,
+    App::FrameArena& arena,
+    ImDrawList& draw_list) {
+  constexpr App::Plot::LayerId id = 1;
+  arena.reset();
+  draw_list._ResetForNewFrame();
+  draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+  draw_list.PushClipRectFullScreen();
+
+  evaluator.submit(id, text, std::span<const double>{}, view);
+  const bool updated = layer.update(evaluator, id);
+  layer.draw(&draw_list, ImVec2(400.0F, 300.0F), view.zoom, 6.0F, arena);
+  return updated;
+}
+
+}  // namespace
+
+TEST_SUITE("Core::FrameArena") {
+  TEST_CASE("Allocations are aligned and do not overlap") {
+    App::FrameArena arena(64);
+
+    auto* const byte = static_cast<std::byte*>(arena.allocate(1, 1));
+    auto* const number = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    // More than the first block holds
+    auto* const large = static_cast<std::byte*>(arena.allocate(256, 16));
+
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(number) % alignof(double), 0U);
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(large) % 16, 0U);
+    CHECK_GE(reinterpret_cast<std::byte*>(number), byte + 1);
+    CHECK_GE(arena.capacity(), 64U + 256U);
+  }
+
+  TEST_CASE("A reset merges the blocks a frame overflowed into") {
+    App::FrameArena arena(64);
+    for (int i = 0; i < 8; ++i) {
+      (void)arena.allocate(100, 8);
+    }
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    CHECK_EQ(arena.capacity(), capacity);
+
+    // The same frame again fits the merged block
+    const std::uint64_t before = App::Debug::allocation_count();
+    for (int i = 0; i < 8; ++i) {
+      (void)arena.allocate(100, 8);
+    }
+    arena.reset();
+    const std::uint64_t after = App::Debug::allocation_count();
+    CHECK_EQ(after - before, 0U);
+    CHECK_EQ(arena.capacity(), capacity);
+  }
+
+  TEST_CASE("Frames allocate nothing from the heap once warmed up") {
+    std::vector<ImVec2> strip;
+    for (int i = 0; i < 20000; ++i) {
+      const float x = static_cast<float>(i) * 0.05F;
+      strip.emplace_back(x, 100.0F * std::sin(x));
+    }
+    App::FrameArena arena;
+    App::Plot::PolylineDecimator decimator;
+
+    // The first frame overflows the default block, the second starts by merging the blocks
+    const std::size_t kept = draw_frame(arena, decimator, strip);
+    REQUIRE_GT(kept, 0U);
+    REQUIRE_EQ(draw_frame(arena, decimator, strip), kept);
+
+    const std::uint64_t before = App::Debug::allocation_count();
+    std::size_t steady = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+      steady = draw_frame(arena, decimator, strip);
+    }
+    const std::uint64_t after = App::Debug::allocation_count();
+    CHECK_EQ(after - before, 0U);
+    CHECK_EQ(steady, kept);
+  }
+
+  TEST_CASE("Submitting, updating and drawing a settled plot allocates nothing") {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(800.0F, 600.0F);
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImGui::NewFrame();
+
+    {
+      // Longer than any small-string buffer, kept in a char array like the layer list does
+      std::array<char, 256> text{"r = 1 + 0.5*cos(theta) + 0.25*sin(3*theta)"};
+      const App::Plot::PlotView view{100.0F, ImVec2(800.0F, 600.0F), ImVec2(0.0F, 0.0F)};
+      App::Plot::PlotEvaluator evaluator;
+      App::Plot::PlotLayer layer(nullptr);
+      App::FrameArena arena;
+      ImDrawList draw_list(ImGui::GetDrawListSharedData());
+
+      // Until the evaluation thread is idle, it allocates as it compiles and samples
+      bool has_result = false;
+      for (int i = 0; i < 5000 && (!has_result || evaluator.busy()); ++i) {
+        has_result = plot_frame(evaluator, layer, text.data(), view, arena, draw_list) ||
+                     has_result;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      REQUIRE(has_result);
+      REQUIRE_FALSE(evaluator.busy());
+      // Warm-up: takes the last result and grows the arena and the draw list
+      for (int frame = 0; frame < 3; ++frame) {
+        plot_frame(evaluator, layer, text.data(), view, arena, draw_list);
+      }
+      const int vertices = draw_list.VtxBuffer.Size;
+
+      const std::uint64_t before = App::Debug::allocation_count();
+      for (int frame = 0; frame < 10; ++frame) {
+        plot_frame(evaluator, layer, text.data(), view, arena, draw_list);
+      }
+      const std::uint64_t after = App::Debug::allocation_count();
+      CHECK_EQ(after - before, 0U);
+      CHECK_GT(vertices, 0);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
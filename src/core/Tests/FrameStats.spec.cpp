@@ -0,0 +1,70 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Core/Debug/Allocations.hpp"
+#include "Core/Debug/FrameStats.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::Debug::FrameStats") {
+  TEST_CASE("An empty series summarizes to zero") {
+    const App::Debug::RollingSeries series;
+    std::vector<float> scratch;
+
+    const App::Debug::RollingSeries::Summary summary = series.summary(scratch);
+    CHECK_EQ(summary.count, 0U);
+    CHECK_EQ(summary.p99, 0.0F);
+  }
+
+  TEST_CASE("Percentiles are taken over the most recent values only") {
+    App::Debug::RollingSeries series;
+    constexpr auto capacity = App::Debug::RollingSeries::capacity;
+
+    // Older values are pushed out by 1..capacity
+    for (std::size_t i = 0; i < capacity; ++i) {
+      series.add(1000.0F);
+    }
+    for (std::size_t i = 1; i <= capacity; ++i) {
+      series.add(static_cast<float>(i));
+    }
+
+    std::vector<float> values;
+    series.snapshot(values);
+    REQUIRE_EQ(values.size(), capacity);
+    CHECK_EQ(values.front(), 1.0F);
+    CHECK_EQ(values.back(), static_cast<float>(capacity));
+
+    std::vector<float> scratch;
+    const App::Debug::RollingSeries::Summary summary = series.summary(scratch);
+    CHECK_EQ(summary.count, capacity);
+    CHECK_EQ(summary.last, static_cast<float>(capacity));
+    CHECK_EQ(summary.p50, doctest::Approx(0.50 * capacity).epsilon(0.01));
+    CHECK_EQ(summary.p95, doctest::Approx(0.95 * capacity).epsilon(0.01));
+    CHECK_EQ(summary.p99, doctest::Approx(0.99 * capacity).epsilon(0.01));
+  }
+
+  TEST_CASE("Stage timers add to their stage") {
+    const auto& series = App::Debug::FrameStats::get().stage(App::Debug::Stage::Compile);
+    std::vector<float> before;
+    series.snapshot(before);
+
+    { const App::Debug::StageTimer timer(App::Debug::Stage::Compile); }
+
+    std::vector<float> after;
+    series.snapshot(after);
+    CHECK_EQ(after.size(), before.size() + 1);
+    CHECK_GE(after.back(), 0.0F);
+  }
+
+  TEST_CASE("Heap allocations are counted") {
+    const std::uint64_t before = App::Debug::allocation_count();
+    const auto value = std::make_unique<int>(42);
+    CHECK_EQ(*value, 42);
+    CHECK_GT(App::Debug::allocation_count(), before);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Core/Headless.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+// Parses "App --headless --expr y=x" followed by `options`
+std::optional<App::HeadlessSettings> parse(std::initializer_list<const char*> options) {
+  std::vector<std::string> strings{"App", "--headless", "--expr", "y=x"};
+  strings.insert(strings.end(), options.begin(), options.end());
+
+  std::vector<char*> arguments;
+  for (std::string& argument : strings) {
+    arguments.push_back(argument.data());
+  }
+  return App::HeadlessSettings::parse(std::span<char* const>(arguments));
+}
+
+}  // namespace
+
+TEST_SUITE("Core::HeadlessSettings") {
+  TEST_CASE("Is only requested with --headless") {
+    std::string program{"App"};
+    std::string headless{"--headless"};
+    std::vector<char*> arguments{program.data()};
+    CHECK_FALSE(App::HeadlessSettings::requested(arguments));
+    arguments.push_back(headless.data());
+    CHECK(App::HeadlessSettings::requested(arguments));
+  }
+
+  TEST_CASE("Needs an expression") {
+    std::string program{"App"};
+    std::string headless{"--headless"};
+    std::vector<char*> arguments{program.data(), headless.data()};
+    CHECK_FALSE(App::HeadlessSettings::parse(arguments).has_value());
+  }
+
+  TEST_CASE("Fits [-10, 10] along the shorter side without a zoom") {
+    const auto settings = parse({"--size", "400x200", "--out", "graph.png"});
+    REQUIRE(settings.has_value());
+    CHECK_EQ(settings->expression, "y=x");
+    CHECK(settings->output == "graph.png");
+    CHECK_EQ(settings->width, 400);
+    CHECK_EQ(settings->height, 200);
+    CHECK_EQ(settings->zoom, doctest::Approx(10.0F));
+  }
+
+  TEST_CASE("Accepts valid sizes, zooms, centers and engines") {
+    const auto settings =
+        parse({"--size", "16384x1", "--zoom", "2.5", "--center", "1.5,-2", "--engine", "quadtree"});
+    REQUIRE(settings.has_value());
+    CHECK_EQ(settings->width, 16384);
+    CHECK_EQ(settings->height, 1);
+    CHECK_EQ(settings->zoom, doctest::Approx(2.5F));
+    CHECK_EQ(settings->center.x, doctest::Approx(1.5F));
+    CHECK_EQ(settings->center.y, doctest::Approx(-2.0F));
+    CHECK(settings->implicit_engine == App::Plot::ImplicitEngine::Quadtree);
+
+    const auto grid = parse({"--engine", "grid"});
+    REQUIRE(grid.has_value());
+    CHECK(grid->implicit_engine == App::Plot::ImplicitEngine::Grid);
+  }
+
+  TEST_CASE("Rejects invalid sizes") {
+    for (const char* size : {"", "640", "640x", "x480", "0x480", "640x-1", "16385x16", "6a0x480",
+             "640x480x2", "1.5x2"}) {
+      CAPTURE(size);
+      CHECK_FALSE(parse({"--size", size}).has_value());
+    }
+  }
+
+  TEST_CASE("Rejects invalid zooms") {
+    for (const char* zoom : {"", "0", "-3", "ten", "2px"}) {
+      CAPTURE(zoom);
+      CHECK_FALSE(parse({"--zoom", zoom}).has_value());
+    }
+  }
+
+  TEST_CASE("Rejects invalid centers") {
+    for (const char* center : {"", "1", "1,", ",2", "1;2", "a,b"}) {
+      CAPTURE(center);
+      CHECK_FALSE(parse({"--center", center}).has_value());
+    }
+  }
+
+  TEST_CASE("Rejects unknown engines, options and missing values") {
+    CHECK_FALSE(parse({"--engine", "Grid"}).has_value());
+    CHECK_FALSE(parse({"--engine", "marching"}).has_value());
+    CHECK_FALSE(parse({"--colour", "red"}).has_value());
+    CHECK_FALSE(parse({"--zoom"}).has_value());
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,123 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Debug/Instrumentor.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::Debug::Instrumentor") {
+  TEST_CASE("Events are drained in order and dropped once the ring is full") {
+    App::Debug::ProfileEventBuffer buffer(0);
+    constexpr std::size_t capacity = App::Debug::ProfileEventBuffer::capacity;
+
+    for (std::size_t i = 0; i < capacity; ++i) {
+      REQUIRE(buffer.push({"event", static_cast<std::int64_t>(i), 0}));
+    }
+    CHECK_FALSE(buffer.push({"event", -1, 0}));
+    CHECK_FALSE(buffer.push({"event", -1, 0}));
+    CHECK_EQ(buffer.take_dropped(), 2U);
+    CHECK_EQ(buffer.take_dropped(), 0U);
+
+    std::int64_t expected = 0;
+    bool in_order = true;
+    CHECK_EQ(buffer.drain([&](const App::Debug::ProfileEvent& event) {
+      in_order = in_order && event.start == expected++;
+    }),
+        capacity);
+    CHECK(in_order);
+
+    // Draining frees the slots again
+    CHECK(buffer.push({"event", 0, 0}));
+    CHECK_EQ(buffer.drain([](const App::Debug::ProfileEvent&) {}), 1U);
+  }
+
+  TEST_CASE("A concurrent drain sees every pushed event exactly once") {
+    App::Debug::ProfileEventBuffer buffer(0);
+    constexpr std::int64_t count = 200000;
+
+    std::thread producer([&buffer] {
+      for (std::int64_t i = 0; i < count; ++i) {
+        while (!buffer.push({"event", i, i + 1})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    std::int64_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+      buffer.drain([&](const App::Debug::ProfileEvent& event) {
+        in_order = in_order && event.start == expected && event.end == expected + 1;
+        ++expected;
+      });
+    }
+    producer.join();
+
+    CHECK(in_order);
+    CHECK_EQ(expected, count);
+  }
+
+  TEST_CASE("A session writes the scopes of every thread as trace events") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "InstrumentorTest.json";
+
+    App::Debug::Instrumentor::get().begin_session("Test", path.string());
+    {
+      const App::Debug::InstrumentationTimer timer("MainScope");
+      std::thread worker([] { const App::Debug::InstrumentationTimer inner("WorkerScope"); });
+      worker.join();
+    }
+    App::Debug::Instrumentor::get().end_session();
+
+    // Scopes outside a session are not recorded
+    { const App::Debug::InstrumentationTimer timer("LateScope"); }
+
+    std::ifstream file(path);
+    const std::string json{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    file.close();
+    std::filesystem::remove(path);
+
+    CHECK_EQ(json.rfind(R"({"otherData": {},"traceEvents":[{})", 0), 0U);
+    CHECK_EQ(json.substr(json.size() - 2), "]}");
+    CHECK_NE(json.find(R"("name":"MainScope")"), std::string::npos);
+    CHECK_NE(json.find(R"("name":"WorkerScope")"), std::string::npos);
+    CHECK_EQ(json.find("LateScope"), std::string::npos);
+  }
+
+  TEST_CASE("Threads that exit release their buffers after the last drain") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "InstrumentorThreadsTest.json";
+    App::Debug::Instrumentor& instrumentor = App::Debug::Instrumentor::get();
+
+    instrumentor.begin_session("Threads", path.string());
+    const std::size_t buffers = instrumentor.thread_buffer_count();
+    for (int round = 0; round < 8; ++round) {
+      std::thread worker([] { const App::Debug::InstrumentationTimer timer("ShortLived"); });
+      worker.join();
+    }
+    CHECK_EQ(instrumentor.thread_buffer_count(), buffers);
+    instrumentor.end_session();
+
+    std::ifstream file(path);
+    const std::string json{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    file.close();
+    std::filesystem::remove(path);
+
+    std::size_t events = 0;
+    for (std::size_t at = json.find("ShortLived"); at != std::string::npos;
+         at = json.find("ShortLived", at + 1)) {
+      ++events;
+    }
+    CHECK_EQ(events, 8U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,95 @@
+#include <SDL2/SDL.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <doctest/doctest.h>
+#include <imgui.h>
+
+#include <cstdint>
+
+#include "Core/Plot/LayerCache.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+constexpr int canvas_size = 64;
+
+// Draws a layer through `cache` and counts how often its geometry is issued
+void draw(App::Plot::LayerCache& cache,
+    const App::Plot::CanvasView& view,
+    std::uint64_t revision,
+    int& draws) {
+  cache.draw(ImGui::GetBackgroundDrawList(),
+      view,
+      revision,
+      [&draws](ImDrawList* draw_list, const App::Plot::CanvasView& layer_view) {
+        ++draws;
+        draw_list->AddLine(ImVec2(layer_view.min.x, layer_view.origin.y),
+            ImVec2(layer_view.max.x, layer_view.origin.y),
+            IM_COL32(0, 0, 0, 255));
+      });
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::LayerCache") {
+  TEST_CASE("A layer is only rendered again when its revision or the view changes") {
+    SDL_Surface* surface =
+        SDL_CreateRGBSurfaceWithFormat(0, canvas_size, canvas_size, 32, SDL_PIXELFORMAT_ABGR8888);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+    // Without render targets the layer is drawn every frame by design
+    REQUIRE(SDL_RenderTargetSupported(renderer) == SDL_TRUE);
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(canvas_size, canvas_size);
+    io.DeltaTime = 1.0F / 60.0F;
+    ImGui_ImplSDLRenderer2_Init(renderer);
+    ImGui_ImplSDLRenderer2_NewFrame();
+    ImGui::NewFrame();
+
+    {
+      // The cache's texture belongs to the renderer, so it goes before it
+      App::Plot::LayerCache cache(renderer);
+      const App::Plot::CanvasView view{
+          ImVec2(0.0F, 0.0F), ImVec2(canvas_size, canvas_size), ImVec2(32.0F, 32.0F), 10.0F};
+      int draws = 0;
+
+      draw(cache, view, 1, draws);
+      CHECK_EQ(draws, 1);
+
+      draw(cache, view, 1, draws);
+      CHECK_EQ(draws, 1);
+
+      draw(cache, view, 2, draws);
+      CHECK_EQ(draws, 2);
+
+      App::Plot::CanvasView panned = view;
+      panned.origin.x += 5.0F;
+      draw(cache, panned, 2, draws);
+      CHECK_EQ(draws, 3);
+
+      // The canvas moved on the screen, the world did not move on the canvas
+      App::Plot::CanvasView moved = panned;
+      moved.min.x += 8.0F;
+      moved.max.x += 8.0F;
+      moved.origin.x += 8.0F;
+      draw(cache, moved, 2, draws);
+      CHECK_EQ(draws, 3);
+
+      cache.reset();
+      draw(cache, moved, 2, draws);
+      CHECK_EQ(draws, 4);
+    }
+
+    ImGui::EndFrame();
+    ImGui_ImplSDLRenderer2_Shutdown();
+    ImGui::DestroyContext();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
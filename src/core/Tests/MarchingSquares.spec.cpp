@@ -0,0 +1,81 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "Core/Plot/MarchingSquares.hpp"
+#include "Core/Plot/Polylines.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+template <typename F>
+App::Plot::ScalarGrid sample_grid(F f, double extent, double step) {
+  App::Plot::ScalarGrid grid;
+  grid.x_min = -extent;
+  grid.y_min = -extent;
+  grid.step = step;
+  const auto nodes = static_cast<std::size_t>(2.0 * extent / step) + 1;
+  grid.resize(nodes, nodes);
+  for (std::size_t row = 0; row < grid.rows; ++row) {
+    for (std::size_t column = 0; column < grid.columns; ++column) {
+      grid.values[row * grid.columns + column] = f(grid.x(column), grid.y(row));
+    }
+  }
+  return grid;
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::MarchingSquares") {
+  TEST_CASE("A circle becomes one closed polyline") {
+    const auto grid =
+        sample_grid([](double x, double y) { return x * x + y * y - 1.0; }, 2.0, 0.05);
+
+    App::Plot::ContourExtractor extractor;
+    App::Plot::Polylines out;
+    extractor.extract(grid, out);
+
+    REQUIRE_EQ(out.strip_count(), 1U);
+    const auto strip = out.strip(0);
+    CHECK_EQ(strip.front().x, doctest::Approx(strip.back().x));
+    CHECK_EQ(strip.front().y, doctest::Approx(strip.back().y));
+    for (const ImVec2& point : strip) {
+      CHECK_EQ(std::hypot(point.x, point.y), doctest::Approx(1.0).epsilon(0.01));
+    }
+  }
+
+  TEST_CASE("Separate components stay separate") {
+    const auto grid = sample_grid(
+        [](double x, double y) {
+          const double left = (x + 1.0) * (x + 1.0) + y * y - 0.25;
+          const double right = (x - 1.0) * (x - 1.0) + y * y - 0.25;
+          return std::min(left, right);
+        },
+        2.0,
+        0.05);
+
+    App::Plot::ContourExtractor extractor;
+    App::Plot::Polylines out;
+    extractor.extract(grid, out);
+
+    CHECK_EQ(out.strip_count(), 2U);
+  }
+
+  TEST_CASE("Open curves run from border to border") {
+    const auto grid = sample_grid([](double x, double y) { return y - x * x; }, 1.0, 0.1);
+
+    App::Plot::ContourExtractor extractor;
+    App::Plot::Polylines out;
+    extractor.extract(grid, out);
+
+    REQUIRE_EQ(out.strip_count(), 1U);
+    const auto strip = out.strip(0);
+    CHECK_EQ(std::abs(strip.front().y), doctest::Approx(1.0));
+    CHECK_EQ(std::abs(strip.back().y), doctest::Approx(1.0));
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/Plot/PlotDescription.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+using App::Plot::describe_plot;
+using App::Plot::PlotMode;
+
+bool reads_exactly(std::string_view text, const std::vector<std::string>& names) {
+  return describe_plot(text).free_variables == names;
+}
+
+bool has_parameters(std::string_view text, const std::vector<std::string>& names) {
+  return describe_plot(text).parameters == names;
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::PlotDescription") {
+  TEST_CASE("Each mode is told apart by its top-level operators") {
+    CHECK_EQ(describe_plot("sin(x)").mode, PlotMode::Explicit);
+    CHECK_EQ(describe_plot("(cos(t), sin(t))").mode, PlotMode::Parametric);
+    CHECK_EQ(describe_plot("x^2 + y^2 < 1").mode, PlotMode::Inequality);
+    CHECK_EQ(describe_plot("x != y").mode, PlotMode::Inequality);
+    CHECK_EQ(describe_plot("x^2 + y^2 = 1").mode, PlotMode::Implicit);
+    CHECK_EQ(describe_plot("y == x^2").mode, PlotMode::Implicit);
+    CHECK_EQ(describe_plot("r = 1 + 0.5*cos(theta)").mode, PlotMode::Polar);
+    CHECK_EQ(describe_plot("  \n").mode, PlotMode::None);
+  }
+
+  TEST_CASE("Operators inside brackets do not count") {
+    CHECK_EQ(describe_plot("(x > 0)").mode, PlotMode::Explicit);
+    CHECK_EQ(describe_plot("max(x, 1)").mode, PlotMode::Explicit);
+    CHECK_EQ(describe_plot("(x, 1) * 2").mode, PlotMode::Explicit);
+    CHECK_EQ(describe_plot("(x^2 = 1)").mode, PlotMode::Explicit);
+  }
+
+  TEST_CASE("Parts are split and trimmed") {
+    const auto parametric = describe_plot("\n ( cos(t) , max(t, sin(t)) ) ");
+    CHECK_EQ(parametric.primary, "cos(t)");
+    CHECK_EQ(parametric.secondary, "max(t, sin(t))");
+
+    CHECK_EQ(describe_plot("y = x^2").primary, "(y) - (x^2)");
+    CHECK_EQ(describe_plot("x == (y = 1)").primary, "(x) - ((y = 1))");
+    CHECK_EQ(describe_plot("R==theta").primary, "theta");
+    CHECK_EQ(describe_plot(" x <= 1 ").primary, "x <= 1");
+  }
+
+  TEST_CASE("Polar needs r alone on the left and neither x nor y on the right") {
+    CHECK_EQ(describe_plot("r = 2").mode, PlotMode::Polar);
+    CHECK_EQ(describe_plot("r = x").mode, PlotMode::Implicit);
+    CHECK_EQ(describe_plot("r^2 = theta").mode, PlotMode::Implicit);
+    CHECK_EQ(describe_plot("radius = theta").mode, PlotMode::Implicit);
+  }
+
+  TEST_CASE("Free variables leave out functions, constants and keywords") {
+    CHECK(reads_exactly("sin(x) + pi * a", {"a", "x"}));
+    CHECK(reads_exactly("X > 0 and y < E", {"x", "y"}));
+    CHECK(reads_exactly("r = k*theta + φ", {"k", "r", "theta"}));
+    CHECK(reads_exactly("2e", {}));
+  }
+
+  TEST_CASE("Parameters are the free variables other than the mode's own") {
+    CHECK(has_parameters("y = a*sin(b*x)", {"a", "b"}));
+    CHECK(has_parameters("r = k*theta", {"k"}));
+    CHECK(has_parameters("(cos(t), s*sin(t))", {"s"}));
+    CHECK(has_parameters("x^2 + y^2 < R", {"r"}));
+    CHECK(has_parameters("sin(x)", {}));
+  }
+
+  TEST_CASE("An assignment is not an equation") {
+    CHECK_EQ(describe_plot("a := 2").mode, PlotMode::Explicit);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,125 @@
+#include <doctest/doctest.h>
+#include <imgui.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <thread>
+
+#include "Core/Plot/PlotEvaluator.hpp"
+#include "Core/Plot/PlotSampler.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+const App::Plot::PlotView view{100.0F, ImVec2(400.0F, 300.0F), ImVec2(0.0F, 0.0F)};
+
+// Polls until the evaluator has no request left without a result
+bool wait_until_idle(const App::Plot::PlotEvaluator& evaluator) {
+  for (int i = 0; i < 10000; ++i) {
+    if (!evaluator.busy()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+bool on_unit_circle(const App::Plot::PlotResult& result) {
+  for (const ImVec2& point : result.samples.points) {
+    if (std::abs(std::hypot(point.x, point.y) - 1.0F) > 1.0e-3F) {
+      return false;
+    }
+  }
+  return !result.samples.points.empty();
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::PlotEvaluator") {
+  TEST_CASE("A layer is busy until its result is ready") {
+    std::atomic<int> results{0};
+    App::Plot::PlotEvaluator evaluator([&results] { results.fetch_add(1); });
+
+    App::Plot::PlotResult result;
+    CHECK_FALSE(evaluator.take(1, result));
+
+    evaluator.submit(1, "(cos(t), sin(t))", {}, view);
+    REQUIRE(wait_until_idle(evaluator));
+    CHECK_GT(results.load(), 0);
+    REQUIRE(evaluator.take(1, result));
+    CHECK(on_unit_circle(result));
+
+    // Taken results are not handed out twice, and an unchanged request is no new work
+    CHECK_FALSE(evaluator.take(1, result));
+    evaluator.submit(1, "(cos(t), sin(t))", {}, view);
+    CHECK_FALSE(evaluator.busy());
+  }
+
+  TEST_CASE("A newer request replaces the one in flight") {
+    App::Plot::PlotEvaluator evaluator;
+
+    // The implicit grid keeps the thread busy long enough for the next request to cancel it
+    evaluator.submit(1, "sin(x*y) = cos(x + y)", {}, view);
+    evaluator.submit(1, "(cos(t), sin(t))", {}, view);
+    REQUIRE(wait_until_idle(evaluator));
+
+    App::Plot::PlotResult result;
+    REQUIRE(evaluator.take(1, result));
+    CHECK_FALSE(result.x_monotonic);
+    CHECK(on_unit_circle(result));
+  }
+
+  TEST_CASE("Parameters are part of the request") {
+    App::Plot::PlotEvaluator evaluator;
+    App::Plot::PlotResult result;
+
+    const double half = 0.5;
+    evaluator.submit(1, "(a*cos(t), a*sin(t))", std::span(&half, 1), view);
+    REQUIRE(wait_until_idle(evaluator));
+    REQUIRE(evaluator.take(1, result));
+    CHECK_FALSE(on_unit_circle(result));
+
+    const double one = 1.0;
+    evaluator.submit(1, "(a*cos(t), a*sin(t))", std::span(&one, 1), view);
+    CHECK(evaluator.busy());
+    REQUIRE(wait_until_idle(evaluator));
+    REQUIRE(evaluator.take(1, result));
+    CHECK(on_unit_circle(result));
+  }
+
+  TEST_CASE("A removed layer is forgotten, even with a job in flight") {
+    App::Plot::PlotEvaluator evaluator;
+    evaluator.submit(1, "sin(x*y) = cos(x + y)", {}, view);
+    evaluator.submit(2, "(cos(t), sin(t))", {}, view);
+    evaluator.remove(1);
+
+    REQUIRE(wait_until_idle(evaluator));
+    App::Plot::PlotResult result;
+    CHECK_FALSE(evaluator.take(1, result));
+    CHECK(evaluator.take(2, result));
+  }
+
+  TEST_CASE("A layer resubmitted all the time does not starve the others") {
+    App::Plot::PlotEvaluator evaluator;
+    evaluator.submit(2, "(cos(t), sin(t))", {}, view);
+
+    // Layer 1 comes first in id order and always has a new request, each missing every
+    // cached tile
+    App::Plot::PlotView moving = view;
+    App::Plot::PlotResult result;
+    bool second_done = false;
+    for (int i = 0; i < 500 && !second_done; ++i) {
+      moving.zoom += 0.01F;
+      evaluator.submit(1, "sin(x*y) = cos(x + y)", {}, moving);
+      second_done = evaluator.take(2, result);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(second_done);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
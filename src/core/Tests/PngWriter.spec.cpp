@@ -0,0 +1,76 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Core/PngWriter.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+std::uint32_t read_u32(const std::vector<std::uint8_t>& bytes, std::size_t offset) {
+  return (static_cast<std::uint32_t>(bytes[offset]) << 24U) |
+         (static_cast<std::uint32_t>(bytes[offset + 1]) << 16U) |
+         (static_cast<std::uint32_t>(bytes[offset + 2]) << 8U) |
+         static_cast<std::uint32_t>(bytes[offset + 3]);
+}
+
+}  // namespace
+
+TEST_SUITE("Core::PngWriter") {
+  TEST_CASE("Writes the signature, header and a terminating chunk") {
+    const std::vector<std::uint32_t> pixels(6 * 4, 0xFF00FF00U);
+    const std::vector<std::uint8_t> png = App::PngWriter::encode(6, 4, 6, pixels);
+
+    const std::vector<std::uint8_t> signature{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    REQUIRE_GT(png.size(), 8U + 25U + 12U);
+    CHECK(std::vector<std::uint8_t>(png.begin(), png.begin() + 8) == signature);
+
+    // IHDR: length 13, then width, height, bit depth 8 and color type RGBA
+    CHECK_EQ(read_u32(png, 8), 13U);
+    CHECK_EQ(png[12], 'I');
+    CHECK_EQ(png[15], 'R');
+    CHECK_EQ(read_u32(png, 16), 6U);
+    CHECK_EQ(read_u32(png, 20), 4U);
+    CHECK_EQ(png[24], 8);
+    CHECK_EQ(png[25], 6);
+
+    // An empty IEND chunk always carries the same CRC
+    const std::size_t end = png.size() - 12;
+    CHECK_EQ(read_u32(png, end), 0U);
+    CHECK_EQ(png[end + 4], 'I');
+    CHECK_EQ(png[end + 7], 'D');
+    CHECK_EQ(read_u32(png, end + 8), 0xAE426082U);
+  }
+
+  TEST_CASE("Flat images compress well below their raw size") {
+    constexpr std::uint32_t size = 256;
+    const std::vector<std::uint32_t> pixels(size * size, 0xFFFFFFFFU);
+    const std::vector<std::uint8_t> png = App::PngWriter::encode(size, size, size, pixels);
+
+    CHECK_LT(png.size(), pixels.size() * 4 / 50);
+  }
+
+  TEST_CASE("Padding past the row width is ignored") {
+    constexpr std::uint32_t width = 5;
+    constexpr std::uint32_t height = 3;
+    constexpr std::size_t stride = 8;
+
+    std::vector<std::uint32_t> tight(width * height);
+    std::vector<std::uint32_t> padded(stride * height, 0x12345678U);
+    for (std::uint32_t y = 0; y < height; ++y) {
+      for (std::uint32_t x = 0; x < width; ++x) {
+        const std::uint32_t pixel = 0xFF000000U | (x * 40U) | (y * 80U << 8U);
+        tight[y * width + x] = pixel;
+        padded[y * stride + x] = pixel;
+      }
+    }
+
+    CHECK(App::PngWriter::encode(width, height, width, tight) ==
+          App::PngWriter::encode(width, height, stride, padded));
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
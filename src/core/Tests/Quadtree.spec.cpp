@@ -0,0 +1,42 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <string_view>
+
+#include "Core/Plot/ExpressionTree.hpp"
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/Quadtree.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::Plot::Quadtree") {
+  TEST_CASE("Evaluations follow the curve instead of the area") {
+    constexpr std::array<std::string_view, 2> variables{"x", "y"};
+    const auto tree = App::Plot::ExpressionTree::parse("x^2 + y^2 - 1", variables);
+    REQUIRE(tree.has_value());
+
+    App::Plot::QuadtreeSettings settings;
+    settings.x_min = -4.0;
+    settings.x_max = 4.0;
+    settings.y_min = -3.0;
+    settings.y_max = 3.0;
+    settings.step = 0.005;
+
+    App::Plot::QuadtreeContourer contourer;
+    App::Plot::Polylines out;
+    const App::Plot::QuadtreeStats stats = contourer.extract(
+        *tree, [](double x, double y) { return x * x + y * y - 1.0; }, settings, out);
+
+    REQUIRE_EQ(out.strip_count(), 1U);
+    for (const ImVec2& point : out.points) {
+      CHECK_EQ(std::hypot(point.x, point.y), doctest::Approx(1.0).epsilon(0.001));
+    }
+
+    // A full grid would need 1600 * 1200 evaluations
+    CHECK_LT(stats.point_evaluations, 10000U);
+    CHECK_LT(stats.interval_evaluations, 20000U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,213 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Core/Plot/RegionMask.hpp"
+#include "Core/ThreadPool.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+unsigned int alpha(std::uint32_t pixel) {
+  return pixel >> 24U;
+}
+
+template <typename F>
+App::Plot::RegionFunction pointwise(F f) {
+  return [f](std::size_t /*worker*/,
+             std::span<const double> xs,
+             std::span<const double> ys,
+             std::span<double> values) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = f(xs[i], ys[i]);
+    }
+  };
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::RegionMask") {
+  TEST_CASE("Only boundary cells are supersampled") {
+    App::Plot::RegionSettings settings;
+    settings.x_min = -1.0;
+    settings.x_max = 1.0;
+    settings.y_min = -1.0;
+    settings.y_max = 1.0;
+    settings.step = 0.1;
+    settings.refinement = 4;
+
+    App::ThreadPool pool(1);
+    App::Plot::RegionRasterizer rasterizer;
+    App::Plot::RegionMask mask;
+    const std::size_t evaluations = rasterizer.rasterize(
+        pointwise([](double x, double /*y*/) { return x > 0.03 ? 1.0 : 0.0; }),
+        settings,
+        mask,
+        pool);
+
+    REQUIRE_EQ(mask.columns, 20U);
+    REQUIRE_EQ(mask.rows, 20U);
+
+    // Columns 9 and 10 straddle the change of classification on every row
+    CHECK_EQ(evaluations, 20U * 20U + 2U * 20U * 16U);
+
+    for (std::size_t row = 0; row < mask.rows; ++row) {
+      CHECK_EQ(alpha(mask.pixels[row * mask.columns + 0]), 0U);
+      CHECK_EQ(alpha(mask.pixels[row * mask.columns + 9]), 0U);
+      // 0.03 cuts the cell [0, 0.1] after the first of four sub-samples
+      CHECK_EQ(alpha(mask.pixels[row * mask.columns + 10]), 180U * 3U / 4U);
+      CHECK_EQ(alpha(mask.pixels[row * mask.columns + 19]), 180U);
+    }
+  }
+
+  TEST_CASE("Rows are stored from the top") {
+    App::Plot::RegionSettings settings;
+    settings.step = 0.5;
+
+    App::ThreadPool pool(1);
+    App::Plot::RegionRasterizer rasterizer;
+    App::Plot::RegionMask mask;
+    rasterizer.rasterize(
+        pointwise([](double /*x*/, double y) { return y > 0.0 ? 1.0 : 0.0; }),
+        settings,
+        mask,
+        pool);
+
+    REQUIRE_EQ(mask.rows, 4U);
+    CHECK_GT(alpha(mask.pixels[0]), 0U);
+    CHECK_EQ(alpha(mask.pixels[3 * mask.columns]), 0U);
+  }
+
+  TEST_CASE("NaN is outside the region") {
+    App::Plot::RegionSettings settings;
+    settings.step = 0.5;
+
+    App::ThreadPool pool(1);
+    App::Plot::RegionRasterizer rasterizer;
+    App::Plot::RegionMask mask;
+    rasterizer.rasterize(pointwise([](double /*x*/, double /*y*/) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }),
+        settings,
+        mask,
+        pool);
+
+    for (const std::uint32_t pixel : mask.pixels) {
+      CHECK_EQ(alpha(pixel), 0U);
+    }
+  }
+
+  TEST_CASE("The mask does not depend on the number of threads") {
+    App::Plot::RegionSettings settings;
+    settings.x_min = -2.0;
+    settings.x_max = 2.0;
+    settings.y_min = -1.5;
+    settings.y_max = 1.5;
+    settings.step = 0.01;
+
+    const App::Plot::RegionFunction disk =
+        pointwise([](double x, double y) { return x * x + y * y < 1.0 ? 1.0 : 0.0; });
+
+    App::ThreadPool serial(1);
+    App::Plot::RegionRasterizer serial_rasterizer;
+    App::Plot::RegionMask serial_mask;
+    const std::size_t serial_evaluations =
+        serial_rasterizer.rasterize(disk, settings, serial_mask, serial);
+
+    App::ThreadPool parallel(4);
+    App::Plot::RegionRasterizer parallel_rasterizer;
+    App::Plot::RegionMask parallel_mask;
+    const std::size_t parallel_evaluations =
+        parallel_rasterizer.rasterize(disk, settings, parallel_mask, parallel);
+
+    CHECK_EQ(serial_evaluations, parallel_evaluations);
+    CHECK(serial_mask.pixels == parallel_mask.pixels);
+  }
+
+  TEST_CASE("Tiles given their texel counts line up with their neighbours") {
+    // As the plot sampler cuts them at a zoom of 100: (x_max - x_min) / step rounds up to
+    // 129 for both of these tiles
+    constexpr std::size_t tile_samples = 128;
+    const double step = 2.0 / 100.0;
+    const double tile = static_cast<double>(tile_samples) * step;
+
+    std::vector<App::Plot::RegionSettings> settings(2);
+    for (std::size_t i = 0; i < settings.size(); ++i) {
+      settings[i].x_min = static_cast<double>(3 + i) * tile;
+      settings[i].x_max = settings[i].x_min + tile;
+      settings[i].y_min = 3.0 * tile;
+      settings[i].y_max = settings[i].y_min + tile;
+      settings[i].step = step;
+      settings[i].columns = tile_samples;
+      settings[i].rows = tile_samples;
+    }
+
+    // The same two tiles as a single mask
+    App::Plot::RegionSettings both = settings[0];
+    both.x_max = settings[1].x_max;
+    both.columns = 2 * tile_samples;
+
+    const App::Plot::RegionFunction band = pointwise([tile](double x, double y) {
+      return std::abs(x + 0.5 * y - 5.8 * tile) < 0.3 ? 1.0 : 0.0;
+    });
+
+    App::ThreadPool pool(3);
+    App::Plot::RegionRasterizer rasterizer;
+    App::Plot::RegionMask left;
+    App::Plot::RegionMask right;
+    App::Plot::RegionMask* const masks[] = {&left, &right};
+    const std::size_t evaluations = rasterizer.rasterize(band, settings, masks, pool);
+
+    App::Plot::RegionMask whole;
+    rasterizer.rasterize(band, both, whole, pool);
+
+    for (const App::Plot::RegionMask* mask : masks) {
+      REQUIRE_EQ(mask->columns, tile_samples);
+      REQUIRE_EQ(mask->rows, tile_samples);
+    }
+    CHECK_EQ(left.x_max(), doctest::Approx(right.x_min));
+    CHECK_EQ(left.y_max(), doctest::Approx(settings[0].y_max));
+    CHECK_GE(evaluations, 2U * tile_samples * tile_samples);
+
+    // The band crosses the seam between the tiles
+    std::size_t left_mismatches = 0;
+    std::size_t right_mismatches = 0;
+    for (std::size_t row = 0; row < tile_samples; ++row) {
+      for (std::size_t column = 0; column < tile_samples; ++column) {
+        const std::size_t texel = row * tile_samples + column;
+        const std::size_t whole_texel = row * whole.columns + column;
+        left_mismatches += left.pixels[texel] != whole.pixels[whole_texel] ? 1 : 0;
+        right_mismatches +=
+            right.pixels[texel] != whole.pixels[whole_texel + tile_samples] ? 1 : 0;
+      }
+    }
+    CHECK_EQ(left_mismatches, 0U);
+    CHECK_EQ(right_mismatches, 0U);
+  }
+
+  TEST_CASE("A cancelled job skips the remaining bands") {
+    App::Plot::RegionSettings settings;
+    settings.step = 0.01;
+
+    // The generation moved on after the job was started
+    const std::atomic<std::uint64_t> generation{2};
+    const App::Plot::CancelToken cancel(generation, 1);
+
+    App::ThreadPool pool(2);
+    App::Plot::RegionRasterizer rasterizer;
+    App::Plot::RegionMask mask;
+    const std::size_t evaluations = rasterizer.rasterize(
+        pointwise([](double /*x*/, double /*y*/) { return 1.0; }), settings, mask, pool, cancel);
+
+    CHECK_EQ(evaluations, 0U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+#include "Core/Plot/SharedSymbols.hpp"
+#include "exprtk.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+// An expression in x reading the shared table, with its own table and parser, as
+// ExpressionCache sets them up
+struct Compiled {
+  double x{0.0};
+  exprtk::symbol_table<double> symbols;
+  exprtk::expression<double> expression;
+  std::unique_ptr<exprtk::parser<double>> parser = std::make_unique<exprtk::parser<double>>();
+};
+
+// Call with the shared symbols' lock held
+bool compile(Compiled& compiled, const char* text) {
+  compiled.symbols.add_variable("x", compiled.x);
+  compiled.expression.register_symbol_table(compiled.symbols);
+  App::Plot::SharedSymbols::get().register_with(compiled.expression);
+  return compiled.parser->compile(text, compiled.expression);
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::SharedSymbols") {
+  TEST_CASE("Expressions read the shared constants and functions") {
+    auto compiled = std::make_unique<Compiled>();
+    {
+      const std::unique_lock lock = App::Plot::SharedSymbols::get().lock();
+      REQUIRE(compile(*compiled, "pi * x + ln(e) + phi - gamma"));
+    }
+
+    compiled->x = 2.0;
+    CHECK_EQ(compiled->expression.value(),
+        doctest::Approx(2.0 * std::numbers::pi + 1.0 + std::numbers::phi - std::numbers::egamma));
+
+    const std::unique_lock lock = App::Plot::SharedSymbols::get().lock();
+    compiled.reset();
+  }
+
+  TEST_CASE("Threads compile, evaluate and release expressions side by side") {
+    constexpr std::size_t thread_count = 8;
+    constexpr int rounds = 200;
+
+    std::vector<int> correct(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+      threads.emplace_back([t, &correct] {
+        App::Plot::SharedSymbols& shared = App::Plot::SharedSymbols::get();
+        for (int round = 0; round < rounds; ++round) {
+          auto compiled = std::make_unique<Compiled>();
+          bool compiled_ok = false;
+          {
+            const std::unique_lock lock = shared.lock();
+            compiled_ok = compile(*compiled, "ln(x) + e");
+          }
+
+          // Evaluating only reads the shared table, so it needs no lock
+          compiled->x = static_cast<double>(t + 1);
+          if (compiled_ok && std::abs(compiled->expression.value() -
+                                      (std::log(compiled->x) + std::numbers::e)) < 1.0e-12) {
+            ++correct[t];
+          }
+
+          const std::unique_lock lock = shared.lock();
+          compiled.reset();
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    for (const int count : correct) {
+      CHECK_EQ(count, rounds);
+    }
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
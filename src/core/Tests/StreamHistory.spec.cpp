@@ -0,0 +1,84 @@
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "Core/Plot/Polylines.hpp"
+#include "Core/Plot/StreamHistory.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::Plot::StreamHistory") {
+  TEST_CASE("Narrow windows draw the raw samples") {
+    App::Plot::StreamHistory history;
+    for (int i = 0; i < 1000; ++i) {
+      history.append({static_cast<double>(i) * 0.1, static_cast<double>(i % 7)});
+    }
+    REQUIRE_EQ(history.end(), 1000U);
+    CHECK_EQ(history.latest().x, doctest::Approx(99.9));
+
+    App::Plot::Polylines out;
+    CHECK_FALSE(history.visible(10.0, 20.0, 800.0, out));
+    // 101 samples in the window and one on either side
+    CHECK_EQ(out.points.size(), 103U);
+    CHECK_EQ(out.points[1].x, doctest::Approx(10.0));
+  }
+
+  TEST_CASE("Wide windows draw from the buckets") {
+    App::Plot::StreamHistory history;
+    constexpr std::size_t count = 500000;
+    for (std::size_t i = 0; i < count; ++i) {
+      history.append(
+          {static_cast<double>(i), i == 123457 ? 1000.0 : std::sin(static_cast<double>(i))});
+    }
+
+    App::Plot::Polylines out;
+    CHECK(history.visible(0.0, static_cast<double>(count), 1000.0, out));
+    // Two points per bucket, however many samples there are per pixel
+    CHECK_EQ(out.points.size(), 2U * (count / App::Plot::StreamHistory::bucket_size + 1));
+
+    float highest = 0.0F;
+    for (const ImVec2& point : out.points) {
+      highest = std::max(highest, point.y);
+    }
+    CHECK_EQ(highest, 1000.0F);
+  }
+
+  TEST_CASE("Old samples are overwritten") {
+    App::Plot::StreamHistory history;
+    const std::uint64_t count = App::Plot::StreamHistory::capacity + 1000;
+    for (std::uint64_t i = 0; i < count; ++i) {
+      history.append({static_cast<double>(i), 1.0});
+    }
+    CHECK_EQ(history.first(), 1000U);
+    CHECK_EQ(history.sample(history.first()).x, 1000.0);
+
+    App::Plot::Polylines out;
+    history.visible(0.0, 2000.0, 4000.0, out);
+    CHECK_EQ(out.points.front().x, 1000.0F);
+  }
+
+  TEST_CASE("Going back in x starts over and missing values break the curve") {
+    App::Plot::StreamHistory history;
+    history.append({5.0, 1.0});
+    history.append({6.0, 2.0});
+    history.append({1.0, 3.0});
+    CHECK_EQ(history.end(), 1U);
+    CHECK_EQ(history.latest().y, 3.0);
+
+    history.append({2.0, std::numeric_limits<double>::quiet_NaN()});
+    history.append({3.0, 4.0});
+    history.append({4.0, 5.0});
+    history.append({std::numeric_limits<double>::quiet_NaN(), 6.0});
+    CHECK_EQ(history.end(), 4U);
+
+    App::Plot::Polylines out;
+    history.visible(0.0, 10.0, 100.0, out);
+    CHECK_EQ(out.strip_count(), 1U);
+    CHECK_EQ(out.points.size(), 2U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
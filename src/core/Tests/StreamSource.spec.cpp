@@ -0,0 +1,245 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Plot/StreamSource.hpp"
+#include "Core/StreamConnection.hpp"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+#if !defined(_WIN32)
+
+namespace {
+
+template <typename Predicate>
+bool wait_until(Predicate predicate) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+// A FIFO in the temporary directory, removed again by the destructor.
+struct Fifo {
+  std::filesystem::path path;
+
+  explicit Fifo(const std::string& name) : path(std::filesystem::temp_directory_path() / name) {
+    std::filesystem::remove(path);
+    REQUIRE_EQ(::mkfifo(path.c_str(), 0600), 0);
+  }
+  ~Fifo() {
+    std::filesystem::remove(path);
+  }
+
+  Fifo(const Fifo&) = delete;
+  Fifo(Fifo&&) = delete;
+  Fifo& operator=(Fifo other) = delete;
+  Fifo& operator=(Fifo&& other) = delete;
+};
+
+void write_all(int descriptor, const void* data, std::size_t size) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t written = ::write(descriptor, bytes, size);
+    REQUIRE_GT(written, 0);
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+// One more line than the ring has room for, and then some
+constexpr std::size_t count = App::Plot::StreamSource::ring_capacity + 10000;
+
+std::string numbered_lines(std::size_t lines) {
+  std::string text;
+  for (std::size_t i = 0; i < lines; ++i) {
+    text += std::to_string(i) + "\n";
+  }
+  return text;
+}
+
+void write_text(int descriptor, const std::string& text) {
+  write_all(descriptor, text.data(), text.size());
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::StreamSource") {
+  TEST_CASE("Text lines from a FIFO") {
+    const Fifo fifo("StreamSourceTextTest.fifo");
+    std::atomic<int> notifications{0};
+    App::Plot::StreamSource source({App::StreamEndpoint::Fifo, fifo.path},
+        [&notifications] { ++notifications; });
+
+    // Opening for writing waits for the source to open its end
+    const int writer = ::open(fifo.path.c_str(), O_WRONLY);
+    REQUIRE_GE(writer, 0);
+    write_text(writer, "time,value\n1\n2,5\n# a comment\n3.5\n4");
+    write_text(writer, ",7\r\n");
+
+    std::vector<App::Plot::StreamSample> samples;
+    CHECK(wait_until([&] {
+      source.drain([&](const App::Plot::StreamSample& sample) { samples.push_back(sample); });
+      return samples.size() >= 4;
+    }));
+    REQUIRE_EQ(samples.size(), 4U);
+    CHECK_EQ(samples[0].x, 0.0);
+    CHECK_EQ(samples[0].y, 1.0);
+    CHECK_EQ(samples[1].x, 2.0);
+    CHECK_EQ(samples[1].y, 5.0);
+    CHECK_EQ(samples[2].x, 2.0);
+    CHECK_EQ(samples[2].y, 3.5);
+    CHECK_EQ(samples[3].x, 4.0);
+    CHECK_EQ(samples[3].y, 7.0);
+
+    const App::Plot::StreamCounters counters = source.counters();
+    CHECK_EQ(counters.samples, 4U);
+    CHECK_EQ(counters.malformed, 1U);
+    CHECK_EQ(counters.dropped, 0U);
+    CHECK(wait_until([&] { return notifications > 0; }));
+
+    // A FIFO outlives its writers
+    ::close(writer);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(source.state() == App::Plot::StreamState::Streaming);
+  }
+
+  TEST_CASE("Binary records split across writes") {
+    const Fifo fifo("StreamSourceBinaryTest.fifo");
+    App::Plot::StreamSource source(
+        {App::StreamEndpoint::Fifo, fifo.path, App::Plot::StreamEncoding::Binary});
+
+    const int writer = ::open(fifo.path.c_str(), O_WRONLY);
+    REQUIRE_GE(writer, 0);
+    const std::vector<double> values{1.0, 10.0, 2.0, 20.0, 3.0, 30.0};
+    const auto* bytes = reinterpret_cast<const char*>(values.data());
+    write_all(writer, bytes, 11);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    write_all(writer, bytes + 11, values.size() * sizeof(double) - 11);
+    ::close(writer);
+
+    std::vector<App::Plot::StreamSample> samples;
+    CHECK(wait_until([&] {
+      source.drain([&](const App::Plot::StreamSample& sample) { samples.push_back(sample); });
+      return samples.size() >= 3;
+    }));
+    REQUIRE_EQ(samples.size(), 3U);
+    CHECK_EQ(samples[1].x, 2.0);
+    CHECK_EQ(samples[2].y, 30.0);
+  }
+
+  TEST_CASE("A full ring drops the newest samples") {
+    const std::string lines = numbered_lines(count);
+    const Fifo fifo("StreamSourceDropTest.fifo");
+    App::Plot::StreamSource source({App::StreamEndpoint::Fifo, fifo.path});
+    const int writer = ::open(fifo.path.c_str(), O_WRONLY);
+    REQUIRE_GE(writer, 0);
+    write_text(writer, lines);
+    ::close(writer);
+
+    CHECK(wait_until([&] {
+      const App::Plot::StreamCounters counters = source.counters();
+      return counters.samples + counters.dropped == count;
+    }));
+    CHECK_EQ(source.counters().samples, App::Plot::StreamSource::ring_capacity);
+    CHECK_EQ(source.counters().dropped, 10000U);
+
+    // Dropped samples leave a gap in the index
+    std::size_t drained = 0;
+    double last = -1.0;
+    source.drain([&](const App::Plot::StreamSample& sample) {
+      ++drained;
+      last = sample.x;
+    });
+    CHECK_EQ(drained, App::Plot::StreamSource::ring_capacity);
+    CHECK_EQ(last, static_cast<double>(App::Plot::StreamSource::ring_capacity - 1));
+  }
+
+  TEST_CASE("A full ring can hold back the writer instead") {
+    const std::string lines = numbered_lines(count);
+    const Fifo fifo("StreamSourceBlockTest.fifo");
+    App::Plot::StreamSource source(
+        {App::StreamEndpoint::Fifo, fifo.path, App::Plot::StreamEncoding::Text,
+            App::Plot::StreamOverflow::Block});
+    std::thread writer_thread([&fifo, &lines] {
+      const int writer = ::open(fifo.path.c_str(), O_WRONLY);
+      write_text(writer, lines);
+      ::close(writer);
+    });
+
+    // Let the ring fill up before draining
+    CHECK(wait_until([&] { return source.counters().blocked > 0; }));
+
+    std::size_t drained = 0;
+    bool in_order = true;
+    CHECK(wait_until([&] {
+      source.drain([&](const App::Plot::StreamSample& sample) {
+        in_order = in_order && sample.y == static_cast<double>(drained);
+        ++drained;
+      });
+      return drained == count;
+    }));
+    writer_thread.join();
+
+    CHECK(in_order);
+    CHECK_EQ(source.counters().dropped, 0U);
+    CHECK_EQ(source.counters().samples, count);
+  }
+
+  TEST_CASE("A Unix socket ends with its connection") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "StreamSourceTest.socket";
+    std::filesystem::remove(path);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE_GE(listener, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.string().copy(static_cast<char*>(address.sun_path), sizeof(address.sun_path) - 1);
+    REQUIRE_EQ(::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    REQUIRE_EQ(::listen(listener, 1), 0);
+
+    App::Plot::StreamSource source({App::StreamEndpoint::UnixSocket, path});
+    const int connection = ::accept(listener, nullptr, nullptr);
+    REQUIRE_GE(connection, 0);
+    write_text(connection, "0.5,1\n1.5,2\n");
+    ::close(connection);
+    ::close(listener);
+    std::filesystem::remove(path);
+
+    CHECK(wait_until([&] { return source.state() == App::Plot::StreamState::Ended; }));
+    std::vector<App::Plot::StreamSample> samples;
+    source.drain([&](const App::Plot::StreamSample& sample) { samples.push_back(sample); });
+    REQUIRE_EQ(samples.size(), 2U);
+    CHECK_EQ(samples[1].x, 1.5);
+  }
+
+  TEST_CASE("Endpoints that cannot be opened fail") {
+    App::Plot::StreamSource source({App::StreamEndpoint::UnixSocket,
+        std::filesystem::temp_directory_path() / "StreamSourceMissing.socket"});
+    CHECK(wait_until([&] { return source.state() == App::Plot::StreamState::Failed; }));
+  }
+}
+
+#endif
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
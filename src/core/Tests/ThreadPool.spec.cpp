@@ -0,0 +1,56 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "Core/ThreadPool.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+TEST_SUITE("Core::ThreadPool") {
+  TEST_CASE("Every index runs exactly once") {
+    App::ThreadPool pool(4);
+    REQUIRE_EQ(pool.size(), 4U);
+
+    std::vector<std::atomic<int>> runs(1000);
+    std::atomic<bool> worker_in_range{true};
+    pool.parallel_for(runs.size(), [&](std::size_t index, std::size_t worker) {
+      runs[index].fetch_add(1);
+      if (worker >= pool.size()) {
+        worker_in_range = false;
+      }
+    });
+
+    for (const std::atomic<int>& count : runs) {
+      CHECK_EQ(count.load(), 1);
+    }
+    CHECK(worker_in_range.load());
+  }
+
+  TEST_CASE("Loops can be run back to back") {
+    App::ThreadPool pool(3);
+
+    for (std::size_t round = 0; round < 200; ++round) {
+      std::atomic<std::size_t> sum{0};
+      pool.parallel_for(round, [&sum](std::size_t index, std::size_t /*worker*/) {
+        sum.fetch_add(index);
+      });
+      CHECK_EQ(sum.load(), round * (round == 0 ? 0 : round - 1) / 2);
+    }
+  }
+
+  TEST_CASE("A pool of one runs on the calling thread") {
+    App::ThreadPool pool(1);
+    REQUIRE_EQ(pool.size(), 1U);
+
+    std::size_t calls = 0;
+    pool.parallel_for(10, [&calls](std::size_t /*index*/, std::size_t worker) {
+      CHECK_EQ(worker, 0U);
+      ++calls;
+    });
+    CHECK_EQ(calls, 10U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
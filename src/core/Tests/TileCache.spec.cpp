@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/Plot/TileCache.hpp"
+
+// NOLINTBEGIN(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)
+
+namespace {
+
+App::Plot::TileKey key(std::int64_t column) {
+  App::Plot::TileKey tile_key;
+  tile_key.column = column;
+  return tile_key;
+}
+
+App::Plot::Tile tile_with_points(std::size_t points) {
+  App::Plot::Tile tile;
+  tile.samples.points.resize(points);
+  tile.samples.points.shrink_to_fit();
+  tile.samples.ends.push_back(static_cast<std::uint32_t>(points));
+  return tile;
+}
+
+}  // namespace
+
+TEST_SUITE("Core::Plot::TileCache") {
+  TEST_CASE("Tiles are found by key") {
+    App::Plot::TileCache cache;
+    cache.insert(key(1), tile_with_points(10));
+
+    const App::Plot::Tile* found = cache.find(key(1));
+    REQUIRE(found != nullptr);
+    CHECK_EQ(found->samples.points.size(), 10U);
+    CHECK(cache.find(key(2)) == nullptr);
+
+    App::Plot::TileKey other_level = key(1);
+    other_level.level = 7;
+    CHECK(cache.find(other_level) == nullptr);
+
+    App::Plot::TileKey other_bound = key(1);
+    other_bound.bound = 3;
+    CHECK(cache.find(other_bound) == nullptr);
+  }
+
+  TEST_CASE("The least recently used tile is evicted first") {
+    const std::size_t tile_bytes = tile_with_points(1000).bytes();
+    App::Plot::TileCache cache(3 * tile_bytes);
+
+    cache.insert(key(1), tile_with_points(1000));
+    cache.insert(key(2), tile_with_points(1000));
+    cache.insert(key(3), tile_with_points(1000));
+    CHECK_EQ(cache.size(), 3U);
+
+    // Using tile 1 makes tile 2 the oldest
+    CHECK(cache.find(key(1)) != nullptr);
+    cache.insert(key(4), tile_with_points(1000));
+
+    CHECK_EQ(cache.size(), 3U);
+    CHECK_LE(cache.bytes(), cache.capacity());
+    CHECK(cache.find(key(1)) != nullptr);
+    CHECK(cache.find(key(2)) == nullptr);
+    CHECK(cache.find(key(3)) != nullptr);
+    CHECK(cache.find(key(4)) != nullptr);
+  }
+
+  TEST_CASE("Lowering the capacity evicts immediately") {
+    const std::size_t tile_bytes = tile_with_points(1000).bytes();
+    App::Plot::TileCache cache(10 * tile_bytes);
+    for (std::int64_t column = 0; column < 10; ++column) {
+      cache.insert(key(column), tile_with_points(1000));
+    }
+
+    cache.set_capacity(2 * tile_bytes);
+    CHECK_EQ(cache.size(), 2U);
+    CHECK(cache.find(key(9)) != nullptr);
+    CHECK(cache.find(key(8)) != nullptr);
+  }
+
+  TEST_CASE("The newest tile survives a capacity below its size") {
+    App::Plot::TileCache cache(1);
+    const App::Plot::Tile& inserted = cache.insert(key(1), tile_with_points(1000));
+    CHECK_EQ(inserted.samples.points.size(), 1000U);
+    CHECK_EQ(cache.size(), 1U);
+  }
+}
+
+// NOLINTEND(misc-use-anonymous-namespace, cppcoreguidelines-avoid-do-while, cert-err33-c)